@@ -0,0 +1,198 @@
+#include "AuctionAssignment.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <utility>
+#include "ThreadPool.h"
+#include "Stats.h"
+
+using namespace std;
+
+// Each phase divides epsilon by this factor until the final epsilon is reached.
+static const double EPSILON_SCALING = 5.0;
+
+AuctionAssignment::AuctionAssignment(int rows, int cols, RowCosts rowCosts, CellCost cellCost, double epsilon)
+    : n(rows), m(cols), rowCosts(std::move(rowCosts)), cellCost(std::move(cellCost)),
+      finalEpsilon(epsilon > 0 ? epsilon : 1.0 / (rows + 1)) {
+}
+
+int AuctionAssignment::maxCost() const {
+    atomic<int> best(0);
+    ThreadPool::shared().parallelFor(0, n, [&](int i) {
+        thread_local vector<int> row;
+        row.resize(m);
+        rowCosts(i, row.data());
+        const int local = *max_element(row.begin(), row.end());
+        int seen = best.load(memory_order_relaxed);
+        while (local > seen && !best.compare_exchange_weak(seen, local, memory_order_relaxed)) {
+        }
+    }, max(1, 16384 / max(1, m)));
+    return best.load();
+}
+
+void AuctionAssignment::forwardPhase(double eps) {
+    // Every phase starts from an empty assignment; only the prices carry over.
+    fill(owner.begin(), owner.end(), -1);
+    fill(assigned.begin(), assigned.end(), -1);
+
+    vector<int> bidders(n);
+    for (int i = 0; i < n; ++i) bidders[i] = i;
+    vector<int> bidCol;
+    vector<double> bidPrice;
+    vector<int> topBidder(m, -1);
+    vector<double> topPrice(m, 0.0);
+    vector<int> contested;
+    vector<int> next;
+
+    ThreadPool& pool = ThreadPool::shared();
+    const int grain = max(1, 16384 / max(1, m));
+
+    while (!bidders.empty()) {
+        const int count = static_cast<int>(bidders.size());
+        bidCol.resize(count);
+        bidPrice.resize(count);
+
+        // Jacobi round: every unassigned row bids against the same prices.
+        pool.parallelFor(0, count, [&](int k) {
+            thread_local vector<int> row;
+            row.resize(m);
+            rowCosts(bidders[k], row.data());
+
+            // Cheapest column by cost + price (first on ties) and the runner-up value.
+            int best = 0;
+            double first = row[0] + price[0];
+            double second = numeric_limits<double>::infinity();
+            for (int j = 1; j < m; ++j) {
+                const double value = row[j] + price[j];
+                if (value < first) {
+                    second = first;
+                    first = value;
+                    best = j;
+                }
+                else if (value < second) {
+                    second = value;
+                }
+            }
+            if (second == numeric_limits<double>::infinity()) second = first;
+            bidCol[k] = best;
+            bidPrice[k] = price[best] + (second - first) + eps;
+        }, grain);
+        bidCount += count;
+
+        // Highest bid per column wins; bidders are in ascending row order, so a
+        // strict comparison hands equal bids to the lower row.
+        for (int k = 0; k < count; ++k) {
+            const int j = bidCol[k];
+            if (topBidder[j] < 0) {
+                contested.push_back(j);
+                topBidder[j] = bidders[k];
+                topPrice[j] = bidPrice[k];
+            }
+            else if (bidPrice[k] > topPrice[j]) {
+                topBidder[j] = bidders[k];
+                topPrice[j] = bidPrice[k];
+            }
+        }
+
+        next.clear();
+        for (int k = 0; k < count; ++k) {
+            if (topBidder[bidCol[k]] != bidders[k]) next.push_back(bidders[k]);
+        }
+        for (int j : contested) {
+            const int previous = owner[j];
+            if (previous >= 0) {
+                assigned[previous] = -1;
+                next.push_back(previous);
+            }
+            owner[j] = topBidder[j];
+            assigned[topBidder[j]] = j;
+            price[j] = topPrice[j];
+            topBidder[j] = -1;
+        }
+        contested.clear();
+
+        sort(next.begin(), next.end());
+        bidders.swap(next);
+    }
+}
+
+void AuctionAssignment::reversePhase(double eps) {
+    // With surplus columns the bound needs every unassigned column priced no
+    // higher than lambda, the lowest price among assigned columns. Unassigned
+    // columns above it bid for rows instead (reverse auction); a row switches
+    // when the column undercuts its current cost + price by more than eps.
+    double lambda = numeric_limits<double>::infinity();
+    for (int j = 0; j < m; ++j) {
+        if (owner[j] >= 0) lambda = min(lambda, price[j]);
+    }
+
+    // total[i] = cost + price of the column row i holds.
+    vector<double> total(n);
+    for (int i = 0; i < n; ++i) {
+        total[i] = cellCost(i, assigned[i]) + price[assigned[i]];
+    }
+
+    deque<int> queue;
+    for (int j = 0; j < m; ++j) {
+        if (owner[j] < 0 && price[j] > lambda) queue.push_back(j);
+    }
+
+    while (!queue.empty()) {
+        const int j = queue.front();
+        queue.pop_front();
+
+        // Row that gains most from column j at price 0, and the runner-up gain.
+        int best = -1;
+        double first = -numeric_limits<double>::infinity();
+        double second = -numeric_limits<double>::infinity();
+        for (int i = 0; i < n; ++i) {
+            const double gain = total[i] - cellCost(i, j);
+            if (gain > first) {
+                second = first;
+                first = gain;
+                best = i;
+            }
+            else if (gain > second) {
+                second = gain;
+            }
+        }
+        ++bidCount;
+
+        if (lambda >= first - eps) {
+            price[j] = lambda;
+            continue;
+        }
+
+        price[j] = max(lambda, second - eps);
+        const int previous = assigned[best];
+        owner[previous] = -1;
+        owner[j] = best;
+        assigned[best] = j;
+        total[best] = cellCost(best, j) + price[j];
+        if (price[previous] > lambda) queue.push_back(previous);
+    }
+}
+
+vector<int> AuctionAssignment::findMinCostAssignment() {
+    STATS_TIMER(AuctionSolve);
+    price.assign(m, 0.0);
+    owner.assign(m, -1);
+    assigned.assign(n, -1);
+    bidCount = 0;
+    phaseCount = 0;
+    if (n == 0 || n > m) return n == 0 ? vector<int>() : vector<int>(n, -1);
+
+    double eps = max(finalEpsilon, maxCost() / 2.0);
+    while (true) {
+        forwardPhase(eps);
+        ++phaseCount;
+        if (eps <= finalEpsilon) break;
+        eps = max(finalEpsilon, eps / EPSILON_SCALING);
+    }
+    if (n < m) {
+        reversePhase(eps);
+    }
+    STATS_ADD(AuctionBids, bidCount);
+    return assigned;
+}
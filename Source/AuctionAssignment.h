@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+// Rectangular assignment (rows <= cols) by Bertsekas' auction algorithm with
+// epsilon scaling. Rows are bidders and columns are objects with prices. In
+// every round all unassigned rows bid at once (Jacobi style) on the shared
+// ThreadPool. Each bid reads one full cost row, so the rounds scale with the
+// core count. Conflicting bids for one column go to the highest bid, and on
+// equal bids to the lower row, so the result does not depend on the number of
+// threads.
+//
+// Costs are never stored. rowCosts(i, out) writes the cols costs of row i and
+// cellCost(i, j) returns one cell. Both must be safe to call concurrently.
+// Memory is therefore O(rows + cols).
+//
+// The assignment is within rows * epsilon of the optimum. With integer costs
+// and epsilon < 1 / rows it is optimal, which is what epsilon <= 0 selects.
+// When rows < cols, the final phase ends with reverse-auction steps. These
+// lower every unassigned column's price to at most the lowest assigned price,
+// which the bound requires.
+class AuctionAssignment {
+public:
+    using RowCosts = std::function<void(int row, int* out)>;
+    using CellCost = std::function<int(int row, int col)>;
+
+    AuctionAssignment(int rows, int cols, RowCosts rowCosts, CellCost cellCost, double epsilon = 0.0);
+
+    // result[i] = column assigned to row i.
+    std::vector<int> findMinCostAssignment();
+
+    double epsilon() const { return finalEpsilon; }
+    long long bids() const { return bidCount; }
+    int phases() const { return phaseCount; }
+
+private:
+    int n;
+    int m;
+    RowCosts rowCosts;
+    CellCost cellCost;
+    double finalEpsilon;
+
+    std::vector<double> price;   // per column
+    std::vector<int> owner;      // per column, -1 = unassigned
+    std::vector<int> assigned;   // per row, -1 = unassigned
+    long long bidCount = 0;
+    int phaseCount = 0;
+
+    int maxCost() const;
+    void forwardPhase(double eps);
+    void reversePhase(double eps);
+};
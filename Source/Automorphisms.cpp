@@ -0,0 +1,161 @@
+#include "Automorphisms.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include "Stats.h"
+
+using namespace std;
+
+static int findRoot(vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+Automorphisms::Automorphisms(const Graph& G, const vector<int>& base)
+    : n(G.size), out(G.size), in(G.size), loop(G.size, false), lesser(G.size) {
+    STATS_TIMER(SymmetryDetection);
+    for (int u = 0; u < n; ++u) {
+        G.forEachOutNeighbor(u, [&](int v) {
+            if (v == u) {
+                loop[u] = true;
+                return;
+            }
+            out[u].push_back(v);
+            in[v].push_back(u);
+        });
+    }
+    for (int u = 0; u < n; ++u) sort(out[u].begin(), out[u].end());
+
+    // Colour 0 = free; fixed base vertices get colours 1, 2, ... on both sides.
+    vector<int> fixedColours(n, 0);
+    for (size_t level = 0; level < base.size() && budget > 0; ++level) {
+        vector<int> left = fixedColours;
+        vector<int> right = fixedColours;
+        refine(left, right);
+        // A discrete colouring admits no automorphism besides the identity.
+        vector<int> sorted = left;
+        sort(sorted.begin(), sorted.end());
+        if (unique(sorted.begin(), sorted.end()) == sorted.end()) break;
+
+        const int b = base[level];
+        vector<int> parent(n);
+        iota(parent.begin(), parent.end(), 0);
+        vector<int> perm;
+        const int mark = static_cast<int>(level) + 1;
+        for (int v = 0; v < n && budget > 0; ++v) {
+            if (v == b || left[v] != left[b] || findRoot(parent, v) == findRoot(parent, b)) continue;
+            vector<int> tryLeft = fixedColours;
+            vector<int> tryRight = fixedColours;
+            tryLeft[b] = mark;
+            tryRight[v] = mark;
+            if (!extend(tryLeft, tryRight, perm)) continue;
+            // perm fixes the earlier base vertices, so its cycles lie in this level's orbits.
+            for (int x = 0; x < n; ++x) {
+                parent[findRoot(parent, x)] = findRoot(parent, perm[x]);
+            }
+        }
+
+        int orbitSize = 0;
+        const int root = findRoot(parent, b);
+        for (int v = 0; v < n; ++v) {
+            if (findRoot(parent, v) != root) continue;
+            ++orbitSize;
+            if (v != b) {
+                lesser[v].push_back(b);
+                ++constraintCount;
+            }
+        }
+        order *= orbitSize;
+        fixedColours[b] = mark;
+    }
+}
+
+bool Automorphisms::refine(vector<int>& left, vector<int>& right) const {
+    int classes = 0;
+    vector<int> signature;
+    while (true) {
+        // Signature = own colour, then the sorted colours of out- and of
+        // in-neighbours; equal signatures get equal new colours on both sides.
+        map<vector<int>, int> names;
+        vector<int> nextLeft(n), nextRight(n);
+        for (int side = 0; side < 2; ++side) {
+            const vector<int>& colour = side == 0 ? left : right;
+            vector<int>& next = side == 0 ? nextLeft : nextRight;
+            for (int v = 0; v < n; ++v) {
+                signature.clear();
+                signature.push_back(colour[v]);
+                signature.push_back(loop[v]);
+                const size_t outStart = signature.size();
+                for (int w : out[v]) signature.push_back(colour[w]);
+                sort(signature.begin() + outStart, signature.end());
+                signature.push_back(-1);
+                const size_t inStart = signature.size();
+                for (int w : in[v]) signature.push_back(colour[w]);
+                sort(signature.begin() + inStart, signature.end());
+                auto it = names.emplace(signature, static_cast<int>(names.size())).first;
+                next[v] = it->second;
+            }
+        }
+        left.swap(nextLeft);
+        right.swap(nextRight);
+
+        vector<int> countLeft(names.size(), 0), countRight(names.size(), 0);
+        for (int v = 0; v < n; ++v) {
+            countLeft[left[v]]++;
+            countRight[right[v]]++;
+        }
+        if (countLeft != countRight) return false;
+        const int now = static_cast<int>(count_if(countLeft.begin(), countLeft.end(), [](int c) { return c > 0; }));
+        if (now == classes) return true;
+        classes = now;
+    }
+}
+
+bool Automorphisms::extend(vector<int> left, vector<int> right, vector<int>& perm) {
+    if (--budget < 0) return false;
+    if (!refine(left, right)) return false;
+
+    // The first colour class with more than one vertex, if any.
+    vector<int> size(n, 0);
+    for (int v = 0; v < n; ++v) size[left[v]]++;
+    int split = -1;
+    for (int c = 0; c < n; ++c) {
+        if (size[c] > 1) {
+            split = c;
+            break;
+        }
+    }
+
+    if (split < 0) {
+        perm.assign(n, -1);
+        vector<int> byColour(n, -1);
+        for (int v = 0; v < n; ++v) byColour[right[v]] = v;
+        for (int v = 0; v < n; ++v) perm[v] = byColour[left[v]];
+        return isAutomorphism(perm);
+    }
+
+    const int x = static_cast<int>(find(left.begin(), left.end(), split) - left.begin());
+    for (int y = 0; y < n && budget > 0; ++y) {
+        if (right[y] != split) continue;
+        vector<int> nextLeft = left;
+        vector<int> nextRight = right;
+        nextLeft[x] = n;
+        nextRight[y] = n;
+        if (extend(std::move(nextLeft), std::move(nextRight), perm)) return true;
+    }
+    return false;
+}
+
+bool Automorphisms::isAutomorphism(const vector<int>& perm) const {
+    // perm is a bijection, so mapping every edge onto an edge is enough.
+    for (int u = 0; u < n; ++u) {
+        if (loop[u] != loop[perm[u]]) return false;
+        for (int v : out[u]) {
+            if (!binary_search(out[perm[u]].begin(), out[perm[u]].end(), perm[v])) return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include "Graph.h"
+
+// Symmetry of a pattern graph G, for breaking it in searches over mappings
+// G -> H. Two mappings f and f o s, s an automorphism of G, need the same
+// added edges, so a search only has to visit one of them.
+//
+// Along a base (a vertex order, normally the search's branching order) the
+// constructor computes the orbit of every base vertex b_i under the
+// automorphisms that fix b_1 .. b_(i-1). Every mapping has an equivalent one
+// that maps b_i below every other vertex of that orbit, for all i at once;
+// below(v) lists the base vertices that must get a smaller image than v.
+//
+// Automorphisms are found by backtracking over pairs of colourings refined
+// together (colour refinement on out- and in-neighbour colours), one search
+// per candidate image, with a shared node budget. Whatever the budget leaves
+// untested is treated as not symmetric, which only weakens the constraints.
+class Automorphisms {
+public:
+    static const long long NODE_BUDGET = 200000;
+
+    Automorphisms(const Graph& G, const std::vector<int>& base);
+
+    bool trivial() const { return constraintCount == 0; }
+    // Base vertices whose images must be smaller than v's; all precede v in the base.
+    const std::vector<int>& below(int v) const { return lesser[v]; }
+    int constraints() const { return constraintCount; }
+    // Order of the automorphism group (a lower bound if the budget ran out).
+    double groupOrder() const { return order; }
+
+private:
+    int n;
+    std::vector<std::vector<int>> out;
+    std::vector<std::vector<int>> in;
+    std::vector<char> loop;
+    std::vector<std::vector<int>> lesser;
+    int constraintCount = 0;
+    double order = 1.0;
+    long long budget = NODE_BUDGET;
+
+    // Refines both colourings with the same colour names until stable; false
+    // when their colour class sizes differ (no automorphism maps one to the other).
+    bool refine(std::vector<int>& left, std::vector<int>& right) const;
+    // Looks for an automorphism p with right[p(v)] == left[v]-class; fills perm.
+    bool extend(std::vector<int> left, std::vector<int> right, std::vector<int>& perm);
+    bool isAutomorphism(const std::vector<int>& perm) const;
+};
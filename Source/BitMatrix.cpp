@@ -0,0 +1,94 @@
+#include "BitMatrix.h"
+#include <algorithm>
+
+using namespace std;
+
+BitMatrix::BitMatrix() : nRows(0), nCols(0), wordsPerRow(0), bits(nullptr) {}
+
+BitMatrix::BitMatrix(int rows, int cols) : nRows(rows), nCols(cols), wordsPerRow(strideFor(cols)) {
+    words.assign(totalWords(), 0);
+    bits = words.data();
+}
+
+BitMatrix::BitMatrix(const BitMatrix& other)
+    : nRows(other.nRows), nCols(other.nCols), wordsPerRow(other.wordsPerRow),
+      words(other.bits, other.bits + other.totalWords()) {
+    bits = words.data();
+}
+
+BitMatrix::BitMatrix(BitMatrix&& other) noexcept
+    : nRows(other.nRows), nCols(other.nCols), wordsPerRow(other.wordsPerRow),
+      words(std::move(other.words)), bits(other.bits), backing(std::move(other.backing)) {
+    other.nRows = other.nCols = other.wordsPerRow = 0;
+    other.words.clear();
+    other.bits = nullptr;
+}
+
+BitMatrix& BitMatrix::operator=(const BitMatrix& other) {
+    if (this != &other) {
+        *this = BitMatrix(other);
+    }
+    return *this;
+}
+
+BitMatrix& BitMatrix::operator=(BitMatrix&& other) noexcept {
+    if (this != &other) {
+        nRows = other.nRows;
+        nCols = other.nCols;
+        wordsPerRow = other.wordsPerRow;
+        words = std::move(other.words);
+        bits = other.bits;
+        backing = std::move(other.backing);
+        other.nRows = other.nCols = other.wordsPerRow = 0;
+        other.words.clear();
+        other.bits = nullptr;
+    }
+    return *this;
+}
+
+BitMatrix BitMatrix::view(int rows, int cols, uint64_t* data, shared_ptr<void> backing) {
+    BitMatrix m;
+    m.nRows = rows;
+    m.nCols = cols;
+    m.wordsPerRow = strideFor(cols);
+    m.bits = data;
+    m.backing = std::move(backing);
+    return m;
+}
+
+int BitMatrix::strideFor(int cols) {
+    int w = (cols + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    return (w + WORDS_PER_LINE - 1) / WORDS_PER_LINE * WORDS_PER_LINE;
+}
+
+int BitMatrix::rowCount(int i) const {
+    const uint64_t* r = row(i);
+    const int w = usedWords();
+    int cnt = 0;
+    for (int k = 0; k < w; ++k) cnt += popcount64(r[k]);
+    return cnt;
+}
+
+long long BitMatrix::count() const {
+    long long cnt = 0;
+    const size_t total = totalWords();
+    for (size_t k = 0; k < total; ++k) cnt += popcount64(bits[k]);
+    return cnt;
+}
+
+void BitMatrix::resize(int rows, int cols) {
+    if (rows == nRows && cols == nCols) return;
+
+    BitMatrix grown(rows, cols);
+    const int keepRows = min(rows, nRows);
+    const int keepWords = min(grown.usedWords(), usedWords());
+    for (int i = 0; i < keepRows; ++i) {
+        copy(row(i), row(i) + keepWords, grown.row(i));
+    }
+    // Drop bits beyond the new column count when shrinking.
+    if (cols < nCols && cols % BITS_PER_WORD != 0 && keepWords > 0) {
+        const uint64_t mask = (uint64_t(1) << (cols % BITS_PER_WORD)) - 1;
+        for (int i = 0; i < keepRows; ++i) grown.row(i)[keepWords - 1] &= mask;
+    }
+    *this = std::move(grown);
+}
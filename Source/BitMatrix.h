@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+inline int popcount64(uint64_t x) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(x));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+inline int countTrailingZeros64(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return static_cast<int>(idx);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// Allocator handing out storage aligned to a cache line, so that every row of a
+// BitMatrix (whose stride is a whole number of lines) starts on its own line.
+template <class T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <class U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <class U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* ptr, std::size_t) noexcept {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+
+    template <class U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <class U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+// Square-or-rectangular 0/1 matrix stored one bit per cell, 64 cells per word.
+// Rows are padded to a multiple of 8 words (one 64-byte cache line) and the whole
+// block is a single contiguous allocation.
+//
+// A matrix can also be a view over words that live elsewhere, e.g. in a
+// copy-on-write file mapping: the view keeps its backing alive, may be written
+// to in place, and turns into an ordinary owning matrix when copied or resized.
+class BitMatrix {
+public:
+    static constexpr int BITS_PER_WORD = 64;
+    static constexpr int WORDS_PER_LINE = 8;
+
+    BitMatrix();
+    BitMatrix(int rows, int cols);
+    BitMatrix(const BitMatrix& other);
+    BitMatrix(BitMatrix&& other) noexcept;
+    BitMatrix& operator=(const BitMatrix& other);
+    BitMatrix& operator=(BitMatrix&& other) noexcept;
+
+    // Wraps rows x strideFor(cols) words at data without copying; data must be
+    // 64-byte aligned, zero beyond cols in every row, and outlive backing.
+    static BitMatrix view(int rows, int cols, uint64_t* data, std::shared_ptr<void> backing);
+    bool isView() const { return backing != nullptr; }
+
+    // Words per row for a given column count: whole cache lines.
+    static int strideFor(int cols);
+
+    int rows() const { return nRows; }
+    int cols() const { return nCols; }
+    int stride() const { return wordsPerRow; }
+    // Number of words actually covering the columns (the rest of the stride is padding).
+    int usedWords() const { return (nCols + BITS_PER_WORD - 1) / BITS_PER_WORD; }
+
+    bool test(int i, int j) const {
+        return (row(i)[j >> 6] >> (j & 63)) & 1u;
+    }
+    void set(int i, int j) { row(i)[j >> 6] |= uint64_t(1) << (j & 63); }
+    void reset(int i, int j) { row(i)[j >> 6] &= ~(uint64_t(1) << (j & 63)); }
+
+    const uint64_t* row(int i) const { return bits + static_cast<std::size_t>(i) * wordsPerRow; }
+    uint64_t* row(int i) { return bits + static_cast<std::size_t>(i) * wordsPerRow; }
+
+    int rowCount(int i) const;
+    long long count() const;
+
+    void resize(int rows, int cols);
+    // Bytes owned on the heap; a view owns none.
+    std::size_t memoryBytes() const { return words.size() * sizeof(uint64_t); }
+
+private:
+    int nRows;
+    int nCols;
+    int wordsPerRow;
+    std::vector<uint64_t, AlignedAllocator<uint64_t>> words;   // empty for a view
+    uint64_t* bits;                                           // words.data() or the viewed words
+    std::shared_ptr<void> backing;                            // keeps a view's words alive
+
+    std::size_t totalWords() const { return static_cast<std::size_t>(nRows) * wordsPerRow; }
+};
@@ -0,0 +1,90 @@
+#include "ColumnSetRanking.h"
+#include <algorithm>
+#include "Stats.h"
+
+using namespace std;
+
+ColumnSetRanking::ColumnSetRanking(const CostMatrixBuilder& costs)
+    : costs(costs), n(costs.rows()), m(costs.cols()), work(costs.rows(), costs.cols()),
+      constraint(costs.cols(), 0) {
+    if (n > m) return;
+    vector<int> row(m);
+    int maxCell = 0;
+    for (int i = 0; i < n; ++i) {
+        costs.buildRow(i, row.data());
+        int64_t* out = work.row(i);
+        for (int j = 0; j < m; ++j) {
+            out[j] = row[j];
+            maxCell = max(maxCell, row[j]);
+        }
+    }
+    big = static_cast<int64_t>(maxCell) * n + 1;
+    push({}, {});
+}
+
+void ColumnSetRanking::constrain(int column, signed char state) {
+    if (constraint[column] == state) return;
+    work.shiftColumn(column, (state - constraint[column]) * big);
+    constraint[column] = state;
+}
+
+void ColumnSetRanking::push(vector<int> forbidden, vector<int> required) {
+    const vector<int> assignment = work.findMinCostAssignment();
+    ++solved;
+    STATS_ADD(RankedSubproblems, 1);
+
+    // Too few columns left, or too many required: the costs could not keep
+    // the assignment inside the constraints.
+    vector<char> used(m, 0);
+    long long cost = 0;
+    for (int i = 0; i < n; ++i) {
+        if (assignment[i] < 0) return;
+        used[assignment[i]] = 1;
+        cost += costs.cost(i, assignment[i]);
+    }
+    for (int c : forbidden) {
+        if (used[c]) return;
+    }
+    for (int c : required) {
+        if (!used[c]) return;
+    }
+    open.push({ cost, created++, assignment, std::move(forbidden), std::move(required) });
+}
+
+bool ColumnSetRanking::next(vector<int>& assignment, long long& cost) {
+    if (open.empty()) return false;
+    Subproblem top = open.top();
+    open.pop();
+    assignment = top.assignment;
+    cost = top.cost;
+
+    vector<char> isRequired(m, 0);
+    for (int c : top.required) isRequired[c] = 1;
+    vector<int> columns;
+    for (int c : top.assignment) {
+        if (!isRequired[c]) columns.push_back(c);
+    }
+    sort(columns.begin(), columns.end());
+    if (columns.empty()) return true;
+
+    // The solver still holds the last child solved. Only the columns whose
+    // constraint differs from this subproblem's are shifted; child j then
+    // differs from child j-1 only in d_(j-1), now required, and d_j, now
+    // forbidden, so every child is a repair of the one before.
+    vector<signed char> target(m, 0);
+    for (int c : top.forbidden) target[c] = 1;
+    for (int c : top.required) target[c] = -1;
+    for (int c = 0; c < m; ++c) constrain(c, target[c]);
+    vector<int> required = top.required;
+    for (size_t j = 0; j < columns.size(); ++j) {
+        constrain(columns[j], 1);
+        vector<int> forbidden = top.forbidden;
+        forbidden.push_back(columns[j]);
+        push(std::move(forbidden), required);
+
+        if (j + 1 == columns.size()) break;
+        constrain(columns[j], -1);
+        required.push_back(columns[j]);
+    }
+    return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <queue>
+#include <vector>
+#include "CostMatrixBuilder.h"
+#include "HungarianAlgorithm.h"
+
+// Ranks the vertex sets an assignment can use: next() returns the cheapest
+// assignment of every distinct set of used columns of a CostMatrixBuilder
+// problem (rows <= cols), each set once, in order of rising cost.
+//
+// This is Murty's k-best partitioning applied to column sets. A subproblem is
+// the plain problem with some columns forbidden and some required. Once its
+// cheapest assignment, on columns S, has been returned, the assignments on
+// other sets split into disjoint children: with d_1 .. d_r the columns of S
+// not yet required, child j also requires d_1 .. d_(j-1) and forbids d_j.
+// Open subproblems wait in a queue ordered by cost, then by creation, so the
+// order is deterministic.
+//
+// Forbidding a column raises its costs, and requiring one lowers them, by more
+// than any whole assignment costs. Solves are incremental: one solver holds the
+// problem throughout, and a constraint is applied with shiftColumn, which
+// moves a column's potential together with its costs. Forbidding re-augments
+// at most the one row on that column, and requiring matches the column along
+// one alternating path, so each child, which differs from the one before in
+// two columns, costs O(1) augmentations. Moving on to the next subproblem only
+// shifts the columns whose constraint differs from the last child's.
+class ColumnSetRanking {
+public:
+    // costs must outlive the ranking.
+    explicit ColumnSetRanking(const CostMatrixBuilder& costs);
+
+    // The next assignment (assignment[i] = column of row i) and its cost;
+    // false once every column set has been returned.
+    bool next(std::vector<int>& assignment, long long& cost);
+    // Subproblems solved so far.
+    long long subproblems() const { return solved; }
+
+private:
+    using Solver = BasicHungarianAlgorithm<int64_t>;
+
+    struct Subproblem {
+        long long cost;
+        long long order;
+        std::vector<int> assignment;
+        std::vector<int> forbidden;
+        std::vector<int> required;
+    };
+    struct Later {
+        bool operator()(const Subproblem& a, const Subproblem& b) const {
+            return a.cost != b.cost ? a.cost > b.cost : a.order > b.order;
+        }
+    };
+
+    const CostMatrixBuilder& costs;
+    int n;
+    int m;
+    int64_t big = 1;   // more than any assignment of the plain costs
+    Solver work;
+    std::vector<signed char> constraint;   // per column in work: 1 forbidden, -1 required
+    std::priority_queue<Subproblem, std::vector<Subproblem>, Later> open;
+    long long created = 0;
+    long long solved = 0;
+
+    // Sets the constraint of column in work to state (0, 1 or -1).
+    void constrain(int column, signed char state);
+    // Solves work and queues its assignment if it meets the constraints.
+    void push(std::vector<int> forbidden, std::vector<int> required);
+};
@@ -0,0 +1,169 @@
+#include "CostMatrixBuilder.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include "ThreadPool.h"
+#include "Stats.h"
+
+using namespace std;
+
+static vector<int> computeInDegrees(const Graph& g) {
+    vector<int> degrees(g.size, 0);
+    for (int i = 0; i < g.size; ++i) {
+        g.forEachOutNeighbor(i, [&](int j) { degrees[j]++; });
+    }
+    return degrees;
+}
+
+CostMatrixBuilder::CostMatrixBuilder(const Graph& G, const Graph& H) : n(G.size), m(H.size) {
+    STATS_TIMER(DegreeComputation);
+    setPattern(G);
+    outH.resize(m);
+    for (int j = 0; j < m; ++j) {
+        outH[j] = H.outDegree(j);
+    }
+    inH = computeInDegrees(H);
+}
+
+CostMatrixBuilder::CostMatrixBuilder(const Graph& G, const OverlayGraph& H) : n(G.size), m(H.size) {
+    STATS_TIMER(DegreeComputation);
+    setPattern(G);
+    outH.resize(m);
+    inH.resize(m);
+    for (int j = 0; j < m; ++j) {
+        outH[j] = H.outDegree(j);
+        inH[j] = H.inDegree(j);
+    }
+}
+
+void CostMatrixBuilder::refreshHost(const OverlayGraph& H, vector<int>& changedColumns) {
+    const size_t listed = changedColumns.size();
+    for (int j = 0; j < m; ++j) {
+        const int out = H.outDegree(j);
+        const int in = H.inDegree(j);
+        if (out != outH[j] || in != inH[j]) {
+            outH[j] = out;
+            inH[j] = in;
+            changedColumns.push_back(j);
+        }
+    }
+    if (listed > 0) {
+        inplace_merge(changedColumns.begin(), changedColumns.begin() + listed, changedColumns.end());
+        changedColumns.erase(unique(changedColumns.begin(), changedColumns.end()), changedColumns.end());
+    }
+}
+
+void CostMatrixBuilder::setPattern(const Graph& G) {
+    outG.resize(n);
+    outLinksG.resize(n);
+    inLinksG = computeInDegrees(G);
+    for (int i = 0; i < n; ++i) {
+        const bool loop = G.hasEdge(i, i);
+        outG[i] = G.outDegree(i);
+        outLinksG[i] = outG[i] - (loop ? 1 : 0);
+        inLinksG[i] -= (loop ? 1 : 0);
+    }
+}
+
+// Seeded random permutation of 0..count-1 as ranks. Raw draws rather than
+// std::shuffle, whose output differs between standard libraries.
+static vector<int> randomRanks(int count, mt19937& rng) {
+    vector<int> ranks(count);
+    for (int k = 0; k < count; ++k) ranks[k] = k;
+    for (int k = count - 1; k > 0; --k) swap(ranks[k], ranks[rng() % (k + 1)]);
+    return ranks;
+}
+
+void CostMatrixBuilder::setVariant(unsigned variant) {
+    if (variant == 0) {
+        rankG.clear();
+        rankH.clear();
+        jitterSeed = 0;
+        return;
+    }
+    mt19937 rng(variant);
+    rankG = randomRanks(n, rng);
+    rankH = randomRanks(m, rng);
+    jitterSeed = rng();
+}
+
+int CostMatrixBuilder::cost(int i, int j) const {
+    int c = 0;
+    if (outH[j] == 0) c += 20 * outLinksG[i];
+    if (inH[j] == 0) c += 20 * inLinksG[i];
+    c += abs(outG[i] - outH[j]);
+    if (rankG.empty()) {
+        c += (i + j) / 10;
+    }
+    else {
+        // A cheap integer hash of (seed, i, j) for the jitter.
+        uint32_t h = jitterSeed ^ (static_cast<uint32_t>(i) * 0x9E3779B1u) ^ (static_cast<uint32_t>(j) * 0x85EBCA77u);
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        c += (rankG[i] + rankH[j]) / 10 + static_cast<int>(h % 3);
+    }
+    return c + 1;
+}
+
+void CostMatrixBuilder::buildRow(int i, int* out, const vector<bool>* forbidden) const {
+    for (int j = 0; j < m; ++j) {
+        if (forbidden && j < (int)forbidden->size() && (*forbidden)[j]) {
+            out[j] = FORBIDDEN;
+        }
+        else {
+            out[j] = cost(i, j);
+        }
+    }
+}
+
+void CostMatrixBuilder::build(int* matrix, size_t stride,
+                              const vector<bool>* usedCols,
+                              const vector<bool>* forbidRow0) const {
+    STATS_TIMER(CostMatrixBuild);
+    // Rows are independent; small builds are not worth waking the pool for.
+    const int grain = max(1, 16384 / max(1, m));
+    ThreadPool::shared().parallelFor(0, n, [&](int i) {
+        int* out = matrix + static_cast<size_t>(i) * stride;
+        buildRow(i, out, usedCols);
+        if (i == 0 && forbidRow0) {
+            for (int j = 0; j < m && j < (int)forbidRow0->size(); ++j) {
+                if ((*forbidRow0)[j]) out[j] = FORBIDDEN;
+            }
+        }
+    }, grain);
+}
+
+void CostMatrixBuilder::buildCandidates(int k, vector<int>& rowStart, vector<int>& columns,
+                                        vector<int>& costs, const vector<bool>* forbidRow0) const {
+    STATS_TIMER(CostMatrixBuild);
+    k = max(0, min(k, m));
+    rowStart.resize(n + 1);
+    for (int i = 0; i <= n; ++i) rowStart[i] = i * k;
+    columns.resize(static_cast<size_t>(n) * k);
+    costs.resize(static_cast<size_t>(n) * k);
+
+    // Every row has exactly k entries, so rows fill their slices independently.
+    // The full row is scratch of O(m) per thread, never O(n * m).
+    const int grain = max(1, 16384 / max(1, m));
+    ThreadPool::shared().parallelFor(0, n, [&](int i) {
+        thread_local vector<int> row;
+        thread_local vector<int> order;
+        row.resize(m);
+        order.resize(m);
+        buildRow(i, row.data(), i == 0 ? forbidRow0 : nullptr);
+        for (int j = 0; j < m; ++j) order[j] = j;
+
+        auto cheaper = [](int a, int b) { return row[a] < row[b] || (row[a] == row[b] && a < b); };
+        if (k < m) nth_element(order.begin(), order.begin() + k, order.end(), cheaper);
+        sort(order.begin(), order.begin() + k);
+
+        int* outCols = columns.data() + static_cast<size_t>(i) * k;
+        int* outCosts = costs.data() + static_cast<size_t>(i) * k;
+        for (int e = 0; e < k; ++e) {
+            outCols[e] = order[e];
+            outCosts[e] = row[order[e]];
+        }
+    }, grain);
+}
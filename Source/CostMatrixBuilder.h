@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include "Graph.h"
+#include "OverlayGraph.h"
+
+// Builds the Hungarian cost rows for mapping the vertices of G onto H.
+// Degree profiles of both graphs are computed once in the constructor, so a
+// cost cell is O(1) and a full n x m build is O(n * m), split by row across
+// the shared ThreadPool.
+//
+// cost(i, j) = 20 * [G out-neighbours of i other than i] * [H vertex j has no out-edges]
+//            + 20 * [G in-neighbours of i other than i]  * [H vertex j has no in-edges]
+//            + |outdeg_G(i) - outdeg_H(j)| + (i + j) / 10 + 1
+//
+// The (i + j) / 10 term only breaks ties, and arbitrarily. setVariant(v) gives
+// the v-th alternative: i and j are replaced by seeded random ranks of the G
+// and H vertices, and every cell gets a seeded jitter of 0..2, so different
+// variants lead the assignment to different, equally plausible mappings.
+class CostMatrixBuilder {
+public:
+    static const int FORBIDDEN = 1'000'000;
+
+    CostMatrixBuilder(const Graph& G, const Graph& H);
+    // H extended by an overlay; its degrees are read in O(m).
+    CostMatrixBuilder(const Graph& G, const OverlayGraph& H);
+
+    // Re-reads the degrees of H after it gained edges, in O(m). The H vertices
+    // whose degrees changed are merged into changedColumns, which stays
+    // ascending and without repeats: only their columns can have other costs
+    // than before. The caller clears it once the changes are applied.
+    void refreshHost(const OverlayGraph& H, std::vector<int>& changedColumns);
+
+    int rows() const { return n; }
+    int cols() const { return m; }
+
+    int cost(int i, int j) const;
+
+    // 0 = the plain costs above; the same variant always gives the same costs.
+    void setVariant(unsigned variant);
+
+    // Writes the m costs of G vertex i; columns marked in forbidden get FORBIDDEN.
+    void buildRow(int i, int* out, const std::vector<bool>* forbidden = nullptr) const;
+
+    // Writes rows 0..n-1 of a row-major matrix whose rows are stride entries
+    // apart. usedCols is forbidden for every row, forbidRow0 for row 0 only.
+    void build(int* matrix, size_t stride,
+               const std::vector<bool>* usedCols = nullptr,
+               const std::vector<bool>* forbidRow0 = nullptr) const;
+
+    // Keeps only the k cheapest columns of every row (ties to the lower column),
+    // as compressed rows for SparseAssignment: row i owns the entries
+    // rowStart[i] .. rowStart[i+1] of columns / costs, columns ascending.
+    // forbidRow0 marks FORBIDDEN cells of row 0, which sort last.
+    void buildCandidates(int k, std::vector<int>& rowStart, std::vector<int>& columns,
+                         std::vector<int>& costs, const std::vector<bool>* forbidRow0 = nullptr) const;
+
+private:
+    int n;
+    int m;
+    std::vector<int> outG;         // out-degree of G, self-loop included
+    std::vector<int> outLinksG;    // out-neighbours of i other than i
+    std::vector<int> inLinksG;     // in-neighbours of i other than i
+    std::vector<int> outH;
+    std::vector<int> inH;
+    std::vector<int> rankG;        // variant ranks; empty for variant 0
+    std::vector<int> rankH;
+    unsigned jitterSeed = 0;
+
+    // Degree profile of G.
+    void setPattern(const Graph& G);
+};
@@ -0,0 +1,38 @@
+#include "CsrAdjacency.h"
+#include <algorithm>
+
+using namespace std;
+
+CsrAdjacency::CsrAdjacency() : offsets(1, 0) {}
+
+CsrAdjacency::CsrAdjacency(int vertices, vector<pair<int, int>> edges, bool reverse) {
+    if (reverse) {
+        for (auto& e : edges) swap(e.first, e.second);
+    }
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+    offsets.assign(static_cast<size_t>(vertices) + 1, 0);
+    targets.resize(edges.size());
+    for (const auto& e : edges) offsets[e.first + 1]++;
+    for (int u = 0; u < vertices; ++u) offsets[u + 1] += offsets[u];
+    for (size_t k = 0; k < edges.size(); ++k) targets[k] = edges[k].second;
+}
+
+bool CsrAdjacency::contains(int u, int v) const {
+    return binary_search(begin(u), end(u), v);
+}
+
+void CsrAdjacency::grow(int vertices) {
+    if (vertices > this->vertices()) {
+        offsets.resize(static_cast<size_t>(vertices) + 1, offsets.back());
+    }
+}
+
+bool CsrAdjacency::erase(int u, int v) {
+    const int* it = lower_bound(begin(u), end(u), v);
+    if (it == end(u) || *it != v) return false;
+    targets.erase(targets.begin() + (it - targets.data()));
+    for (size_t w = static_cast<size_t>(u) + 1; w < offsets.size(); ++w) offsets[w]--;
+    return true;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Compressed sparse rows of a directed graph: the neighbours of u are
+// targets[offsets[u] .. offsets[u+1]), sorted ascending and without
+// duplicates. Built with reverse = true from the same edge list it is the
+// compressed-column (in-neighbour) view. Memory is O(vertices + edges).
+class CsrAdjacency {
+public:
+    CsrAdjacency();
+    // edges are (from, to) pairs; duplicates are dropped.
+    CsrAdjacency(int vertices, std::vector<std::pair<int, int>> edges, bool reverse);
+
+    int vertices() const { return static_cast<int>(offsets.size()) - 1; }
+    std::size_t edgeCount() const { return targets.size(); }
+    int degree(int u) const { return static_cast<int>(offsets[u + 1] - offsets[u]); }
+    const int* begin(int u) const { return targets.data() + offsets[u]; }
+    const int* end(int u) const { return targets.data() + offsets[u + 1]; }
+    bool contains(int u, int v) const;
+
+    // Adds isolated vertices up to the given count.
+    void grow(int vertices);
+    // Drops one stored edge u -> v in O(edges); false when it is not stored.
+    bool erase(int u, int v);
+
+private:
+    std::vector<std::size_t> offsets;   // vertices + 1 entries
+    std::vector<int> targets;
+};
@@ -0,0 +1,372 @@
+#include "ExactSearch.h"
+#include <algorithm>
+#include <climits>
+#include "Automorphisms.h"
+#include "HungarianAlgorithm.h"
+#include "SubgraphMatcher.h"
+#include "ThreadPool.h"
+#include "Stats.h"
+
+using namespace std;
+
+// The shared incumbent packs (cost, subtree index) so that one atomic min
+// orders incumbents exactly like the sequential search would meet them.
+static uint64_t incumbentKey(int cost, int task) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cost)) << 32) | static_cast<uint32_t>(task);
+}
+
+// Fewer unmapped vertices than this are left to the per-vertex bound: the
+// assignment then rarely prunes more than it.
+static const int MIN_BOUND_ROWS = 3;
+
+ExactSearch::ExactSearch(const Graph& G, const Graph& H, SearchBudget* budget, bool assignmentBound)
+    : G(G), H(H), n(G.size), m(H.size), budget(budget), assignmentBound(assignmentBound),
+      globalBest(incumbentKey(INT_MAX, INT_MAX)) {
+}
+
+void ExactSearch::buildOrder() {
+    // Highest total degree first, then repeatedly the vertex with the most edges
+    // into the already ordered set, so partial costs start accumulating early.
+    vector<int> degree(n, 0);
+    for (int u = 0; u < n; ++u) {
+        degree[u] = G.outDegree(u) + G.inDegree(u);
+    }
+
+    vector<char> placed(n, false);
+    vector<int> links(n, 0);
+    order.clear();
+    for (int step = 0; step < n; ++step) {
+        int pick = -1;
+        for (int u = 0; u < n; ++u) {
+            if (placed[u]) continue;
+            if (pick < 0 || links[u] > links[pick] ||
+                (links[u] == links[pick] && degree[u] > degree[pick])) {
+                pick = u;
+            }
+        }
+        placed[pick] = true;
+        order.push_back(pick);
+        for (int w = 0; w < n; ++w) {
+            if (w == pick) continue;
+            if (G.hasEdge(pick, w)) links[w]++;
+            if (G.hasEdge(w, pick)) links[w]++;
+        }
+    }
+}
+
+void ExactSearch::initState(State& s) const {
+    s.mapping.assign(n, -1);
+    s.usedH.assign(m, false);
+    s.candidates.assign(static_cast<size_t>(n) * m, 0);
+    s.partial.assign(static_cast<size_t>(n) * m, 0);
+    s.bestCost = INT_MAX;
+    s.bestMapping.clear();
+
+    // Self-loops are the only edges decided by a vertex's own image.
+    for (int u = 0; u < n; ++u) {
+        if (!G.hasEdge(u, u)) continue;
+        int* row = s.partialRow(u, m);
+        for (int x = 0; x < m; ++x) {
+            if (!H.hasEdge(x, x)) row[x] = 1;
+        }
+    }
+}
+
+void ExactSearch::assign(State& s, int u, int h, int sign) const {
+    // Mapping u -> h fixes, for every unmapped neighbour w of u and every H vertex x,
+    // whether the edges between u and w would be present if w went to x.
+    const uint64_t* hOut = H.adj.row(h);
+    for (int w = 0; w < n; ++w) {
+        if (w == u || s.mapping[w] != -1) continue;
+        const bool uw = G.hasEdge(u, w);
+        const bool wu = G.hasEdge(w, u);
+        if (!uw && !wu) continue;
+
+        int* row = s.partialRow(w, m);
+        for (int x = 0; x < m; ++x) {
+            int missing = 0;
+            if (uw && !((hOut[x >> 6] >> (x & 63)) & 1u)) missing++;
+            if (wu && !H.hasEdge(x, h)) missing++;
+            row[x] += sign * missing;
+        }
+    }
+}
+
+int ExactSearch::lowerBound(const State& s, int depth) const {
+    int bound = 0;
+    for (int d = depth; d < n; ++d) {
+        const int* row = s.partial.data() + static_cast<size_t>(order[d]) * m;
+        int best = INT_MAX;
+        for (int x = 0; x < m; ++x) {
+            if (!s.usedH[x] && row[x] < best) best = row[x];
+        }
+        bound += best;
+    }
+    return bound;
+}
+
+int ExactSearch::assignmentLowerBound(const State& s, int depth) const {
+    STATS_TIMER(ExactAssignmentBound);
+    const int k = n - depth;
+    const int words = H.adj.usedWords();
+    vector<int> freeH;
+    freeH.reserve(m - depth);
+    vector<uint64_t> freeMask(words, 0);
+    for (int x = 0; x < m; ++x) {
+        if (s.usedH[x]) continue;
+        freeH.push_back(x);
+        freeMask[x >> 6] |= uint64_t(1) << (x & 63);
+    }
+    const int f = static_cast<int>(freeH.size());
+
+    // Out-edges of every free x to the other free vertices, and of every
+    // unmapped u to the other unmapped vertices.
+    vector<int> freeOut(f);
+    for (int j = 0; j < f; ++j) {
+        const int x = freeH[j];
+        const uint64_t* row = H.adj.row(x);
+        int count = 0;
+        for (int w = 0; w < words; ++w) count += popcount64(row[w] & freeMask[w]);
+        freeOut[j] = count - (H.hasEdge(x, x) ? 1 : 0);
+    }
+    vector<int> unmappedOut(k, 0);
+    for (int i = 0; i < k; ++i) {
+        for (int d = depth; d < n; ++d) {
+            if (d != depth + i && G.hasEdge(order[depth + i], order[d])) unmappedOut[i]++;
+        }
+    }
+    auto pairCost = [&](int i, int j) {
+        return s.partial[static_cast<size_t>(order[depth + i]) * m + freeH[j]] + max(0, unmappedOut[i] - freeOut[j]);
+    };
+
+    HungarianAlgorithm solver(k, f);
+    for (int i = 0; i < k; ++i) {
+        int* row = solver.row(i);
+        for (int j = 0; j < f; ++j) row[j] = pairCost(i, j);
+    }
+    const vector<int> assignment = solver.findMinCostAssignment();
+    int bound = 0;
+    for (int i = 0; i < k; ++i) bound += pairCost(i, assignment[i]);
+    return bound;
+}
+
+int ExactSearch::sortedCandidates(State& s, int depth) const {
+    // Cheapest images first so good incumbents are found early; ties keep H order.
+    const int u = order[depth];
+    const int* row = s.partialRow(u, m);
+    int* cand = s.candidates.data() + static_cast<size_t>(depth) * m;
+    // Symmetry breaking: u's image must lie above those of its below() vertices.
+    int floor = -1;
+    for (int w : below[u]) floor = max(floor, s.mapping[w]);
+    int count = 0;
+    for (int x = floor + 1; x < m; ++x) {
+        if (!s.usedH[x]) cand[count++] = x;
+    }
+    const char* domain = inDomain[u].data();
+    stable_sort(cand, cand + count, [row, domain](int a, int b) {
+        return row[a] != row[b] ? row[a] < row[b] : domain[a] > domain[b];
+    });
+    return count;
+}
+
+bool ExactSearch::cutoff(const State& s, int value) const {
+    // A tie with the incumbent of a later subtree is kept, so the subtree that
+    // comes first in sequential order still finds its own first optimal leaf.
+    value = max(value, costFloor);
+    if (value >= s.bestCost) return true;
+    const uint64_t best = globalBest.load(memory_order_relaxed);
+    const int bestCost = static_cast<int>(best >> 32);
+    const int bestTask = static_cast<int>(best & 0xffffffffu);
+    return value > bestCost || (value == bestCost && bestTask <= s.task);
+}
+
+bool ExactSearch::hasIncumbent(const State& s) const {
+    return s.bestCost != INT_MAX || static_cast<int>(globalBest.load(memory_order_relaxed) >> 32) != INT_MAX;
+}
+
+void ExactSearch::publish(int cost, int task) {
+    const uint64_t key = incumbentKey(cost, task);
+    uint64_t seen = globalBest.load(memory_order_relaxed);
+    while (key < seen && !globalBest.compare_exchange_weak(seen, key, memory_order_relaxed)) {
+    }
+    if (budget && key < seen) budget->improved(cost);
+}
+
+void ExactSearch::dfs(State& s, int depth, int cost) {
+    if (budget) {
+        if (budget->stopped()) return;
+        if (s.nodes % SearchBudget::CHECK_INTERVAL == 0 && budget->charge(SearchBudget::CHECK_INTERVAL)) return;
+    }
+    ++s.nodes;
+    if (depth == n) {
+        if (cost < s.bestCost) {
+            s.bestCost = cost;
+            s.bestMapping = s.mapping;
+            publish(cost, s.task);
+        }
+        return;
+    }
+
+    if (cutoff(s, cost + lowerBound(s, depth))) {
+        ++s.pruned;
+        return;
+    }
+    // The assignment bound only pays once there is an incumbent to prune against.
+    if (assignmentBound && n - depth >= MIN_BOUND_ROWS && hasIncumbent(s)) {
+        ++s.boundSolves;
+        if (cutoff(s, cost + assignmentLowerBound(s, depth))) {
+            ++s.boundPruned;
+            ++s.pruned;
+            return;
+        }
+    }
+
+    const int u = order[depth];
+    const int* row = s.partialRow(u, m);
+    const int count = sortedCandidates(s, depth);
+    const int* cand = s.candidates.data() + static_cast<size_t>(depth) * m;
+
+    for (int k = 0; k < count; ++k) {
+        const int h = cand[k];
+        const int next = cost + row[h];
+        if (cutoff(s, next)) {
+            ++s.pruned;
+            break;
+        }
+
+        s.mapping[u] = h;
+        s.usedH[h] = true;
+        assign(s, u, h, +1);
+        dfs(s, depth + 1, next);
+        assign(s, u, h, -1);
+        s.usedH[h] = false;
+        s.mapping[u] = -1;
+        if (budget && budget->stopped()) break;
+    }
+}
+
+ExactSearch::Result ExactSearch::run() {
+    STATS_TIMER(ExactBranchAndBound);
+    Result result;
+    if (n > m) {
+        return result;
+    }
+
+    // Zero-cost pre-pass: an embedding is optimal as it is.
+    SubgraphMatcher matcher(G, H);
+    const SubgraphMatcher::Outcome embedding = matcher.run();
+    result.prepassNodes = matcher.nodes();
+    if (embedding == SubgraphMatcher::Found) {
+        result.mapping = matcher.embedding();
+        result.extensionCost = 0;
+        if (budget) budget->improved(0);
+        return result;
+    }
+    costFloor = (embedding == SubgraphMatcher::NoEmbedding) ? 1 : 0;
+    // Domains that proved there is no embedding say nothing about the order.
+    inDomain.assign(n, vector<char>(m, 0));
+    if (embedding == SubgraphMatcher::Unknown) {
+        for (int u = 0; u < n; ++u) {
+            for (int x = 0; x < m; ++x) inDomain[u][x] = matcher.inDomain(u, x);
+        }
+    }
+
+    buildOrder();
+    const Automorphisms symmetry(G, order);
+    below.assign(n, {});
+    for (int u = 0; u < n; ++u) below[u] = symmetry.below(u);
+    STATS_ADD(SymmetryConstraints, symmetry.constraints());
+    globalBest.store(incumbentKey(INT_MAX, INT_MAX));
+
+    State root;
+    initState(root);
+    if (n == 0) {
+        result.extensionCost = 0;
+        return result;
+    }
+
+    ThreadPool& pool = ThreadPool::shared();
+
+    // Subtree roots in sequential search order. One level is enough when it
+    // already gives every thread several pieces to steal.
+    struct Prefix { int h0; int h1; int cost; };
+    vector<Prefix> prefixes;
+    const int depth = (n >= 2 && m < 4 * pool.size()) ? 2 : 1;
+    const int first = order[0];
+    const int count0 = sortedCandidates(root, 0);
+    for (int k = 0; k < count0; ++k) {
+        const int h0 = root.candidates[k];
+        const int cost0 = root.partialRow(first, m)[h0];
+        if (depth == 1) {
+            prefixes.push_back({ h0, -1, cost0 });
+            continue;
+        }
+        root.mapping[first] = h0;
+        root.usedH[h0] = true;
+        assign(root, first, h0, +1);
+        const int count1 = sortedCandidates(root, 1);
+        const int* row1 = root.partialRow(order[1], m);
+        for (int j = 0; j < count1; ++j) {
+            const int h1 = root.candidates[static_cast<size_t>(m) + j];
+            prefixes.push_back({ h0, h1, cost0 + row1[h1] });
+        }
+        assign(root, first, h0, -1);
+        root.usedH[h0] = false;
+        root.mapping[first] = -1;
+    }
+
+    vector<State> outcome(prefixes.size());
+    ThreadPool::TaskGroup group;
+    for (size_t t = 0; t < prefixes.size(); ++t) {
+        pool.submit(group, [&, t] {
+            State s = root;
+            s.task = static_cast<int>(t);
+            const Prefix& p = prefixes[t];
+            s.nodes = 1;
+            if (!cutoff(s, p.cost)) {
+                s.mapping[first] = p.h0;
+                s.usedH[p.h0] = true;
+                assign(s, first, p.h0, +1);
+                if (p.h1 >= 0) {
+                    const int second = order[1];
+                    s.mapping[second] = p.h1;
+                    s.usedH[p.h1] = true;
+                    assign(s, second, p.h1, +1);
+                }
+                dfs(s, p.h1 >= 0 ? 2 : 1, p.cost);
+            }
+            else {
+                s.pruned = 1;
+            }
+            // The nodes since the last whole interval, which a small task never reaches.
+            if (budget) budget->charge(s.nodes % SearchBudget::CHECK_INTERVAL);
+            // Keep only what the merge needs.
+            State& out = outcome[t];
+            out.bestCost = s.bestCost;
+            out.bestMapping = std::move(s.bestMapping);
+            out.nodes = s.nodes;
+            out.pruned = s.pruned;
+            out.boundSolves = s.boundSolves;
+            out.boundPruned = s.boundPruned;
+        });
+    }
+    pool.wait(group);
+
+    result.complete = !(budget && budget->stopped());
+    result.extensionCost = INT_MAX;
+    for (const State& s : outcome) {
+        result.nodes += s.nodes;
+        result.pruned += s.pruned;
+        result.boundSolves += s.boundSolves;
+        result.boundPruned += s.boundPruned;
+        if (s.bestCost < result.extensionCost) {
+            result.extensionCost = s.bestCost;
+            result.mapping = s.bestMapping;
+        }
+    }
+    STATS_ADD(ExactNodes, result.nodes);
+    STATS_ADD(ExactPruned, result.pruned);
+    STATS_ADD(ExactBoundSolves, result.boundSolves);
+    STATS_ADD(ExactBoundPruned, result.boundPruned);
+    return result;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "Graph.h"
+#include "SearchBudget.h"
+
+// Branch-and-bound search for the injective mapping G -> H that needs the
+// fewest added edges. Vertices of G are branched in a connectivity order; for
+// every still unmapped G vertex u and every H vertex h the search keeps
+// partial[u][h], the number of edges between u and the mapped vertices that
+// would be missing in H if u went to h. The sum over unmapped u of the cheapest
+// free h is an admissible lower bound used to prune against the incumbent.
+//
+// The tree is split into subtrees by the images of the first one or two G
+// vertices and the subtrees run on the shared ThreadPool. All of them prune
+// against one atomically updated global best; the winner is the cheapest
+// subtree result, ties going to the subtree that comes first in sequential
+// search order, so the answer does not depend on the number of threads.
+//
+// With assignmentBound, a node that survives that bound is also bounded by an
+// assignment problem (Gilmore-Lawler style) over the unmapped G vertices and
+// the free H vertices, solved with HungarianAlgorithm. Pair (u, x) costs
+// partial[u][x] plus the out-edges of u into the unmapped vertices that x
+// cannot match with out-edges into the free vertices. It respects that images
+// are distinct, so it prunes far more, at O(k^2 * f) per node.
+//
+// A SubgraphMatcher pre-pass runs first. An embedding it finds (cost 0) is
+// returned at once. When it proves there is none, every completion costs at
+// least 1, so an incumbent of cost 1 ends the search. Otherwise its refined
+// domains order the candidates of equal partial cost, images that could still
+// host a zero-cost embedding first.
+//
+// With a SearchBudget the search stops cooperatively at its node or time
+// limit and returns the best mapping found so far with complete = false;
+// every new global incumbent is reported to the budget.
+//
+// Symmetric patterns are searched once per class of equivalent mappings: the
+// image-order constraints of Automorphisms, taken along the branching order,
+// leave each vertex only the H vertices above the images of its below() list.
+//
+// H is read through its bit-matrix rows, so both graphs must be dense;
+// Graph::FindBestMapping densifies sparse inputs first.
+class ExactSearch {
+public:
+    struct Result {
+        std::vector<int> mapping;   // empty when no injective mapping exists
+        int extensionCost = 0;      // edges of G missing in H under mapping
+        long long nodes = 0;
+        long long pruned = 0;
+        bool complete = true;       // false: stopped by the budget, not proven optimal
+        long long boundSolves = 0;  // assignment bounds computed
+        long long boundPruned = 0;  // nodes pruned by them
+        long long prepassNodes = 0; // nodes of the zero-cost pre-pass
+    };
+
+    ExactSearch(const Graph& G, const Graph& H, SearchBudget* budget = nullptr, bool assignmentBound = true);
+
+    Result run();
+
+private:
+    struct State {
+        std::vector<int> partial;        // n x m, row = G vertex
+        std::vector<int> mapping;
+        std::vector<char> usedH;
+        std::vector<int> candidates;     // per-depth scratch, m entries per level
+        int bestCost = 0;
+        std::vector<int> bestMapping;
+        long long nodes = 0;
+        long long pruned = 0;
+        long long boundSolves = 0;
+        long long boundPruned = 0;
+        int task = 0;                    // subtree index in sequential search order
+
+        int* partialRow(int u, int m) { return partial.data() + static_cast<size_t>(u) * m; }
+    };
+
+    const Graph& G;
+    const Graph& H;
+    int n;
+    int m;
+    SearchBudget* budget;
+    bool assignmentBound;
+
+    std::vector<int> order;              // G vertices in branching order
+    std::vector<std::vector<int>> below; // per G vertex: mapped earlier to a smaller H vertex
+    std::vector<std::vector<char>> inDomain;  // per G vertex: pre-pass domain of H vertices
+    int costFloor = 0;                   // lower bound on the cost of any mapping
+    std::atomic<uint64_t> globalBest;    // incumbentKey(cost, subtree)
+
+    void buildOrder();
+    void initState(State& s) const;
+    void assign(State& s, int u, int h, int sign) const;
+    int lowerBound(const State& s, int depth) const;
+    int assignmentLowerBound(const State& s, int depth) const;
+    int sortedCandidates(State& s, int depth) const;
+    bool cutoff(const State& s, int value) const;
+    bool hasIncumbent(const State& s) const;
+    void publish(int cost, int task);
+    void dfs(State& s, int depth, int cost);
+};
@@ -1,13 +1,16 @@
 #include "Graph.h"
+#include <algorithm>
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <chrono>
 #include <climits>
 #include <functional>
 #include <iostream>
 #include <iomanip>
 #include "HungarianAlgorithm.h"
+#include "ExactSearch.h"
+#include "CostMatrixBuilder.h"
+#include "GraphFile.h"
+#include "Stats.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -17,93 +20,138 @@ using namespace std;
 
 Graph::Graph() : size(0) {}
 
-Graph::Graph(int n) : size(n) {
-    adj.resize(n, vector<int>(n, 0));
+Graph::Graph(int n) : size(n), adj(n, n) {}
+
+Graph::Graph(const vector<vector<int>>& matrix) : size((int)matrix.size()), adj(size, size) {
+    for (int i = 0; i < size; ++i)
+        for (int j = 0; j < size && j < (int)matrix[i].size(); ++j)
+            if (matrix[i][j] != 0) adj.set(i, j);
 }
 
-Graph::Graph(const string& filename, bool first_graph) {
+Graph::Graph(BitMatrix matrix) : size(matrix.rows()), adj(std::move(matrix)) {}
+
+Graph::Graph(const string& filename, bool first_graph) : size(0) {
     loadFromFile(filename, first_graph);
 }
 
 void Graph::loadFromFile(const string& filename, bool first_graph) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Error: Could not open file " << filename << endl;
+    Graph G, H;
+    if (!loadPair(filename, G, H)) {
         size = 0;
+        adj = BitMatrix();
         return;
     }
+    *this = std::move(first_graph ? G : H);
+}
 
-    string line;
-    int n_vertices = 0;
-
-    // Skip first graph if reading second graph from file
-    if (!first_graph) {
-        if (getline(file, line)) {
-            try {
-                int n1 = stoi(line);
-                // Skip adjacency matrix rows
-                for (int i = 0; i < n1; ++i) {
-                    getline(file, line);
-                }
-            }
-            catch (...) {
-                cerr << "Error parsing first graph size" << endl;
-            }
-        }
+Graph Graph::fromEdges(int n, const vector<pair<int, int>>& edges) {
+    Graph g;
+    g.size = n;
+    g.sparse = true;
+    g.out = CsrAdjacency(n, edges, false);
+    g.in = CsrAdjacency(n, edges, true);
+    g.outAdded.resize(n);
+    g.inAdded.resize(n);
+    return g;
+}
+
+Graph Graph::toDense() const {
+    if (!sparse) return *this;
+    Graph g(size);
+    for (int u = 0; u < size; ++u) {
+        forEachOutNeighbor(u, [&](int w) { g.adj.set(u, w); });
     }
+    return g;
+}
 
-    // Read target graph
-    if (getline(file, line)) {
-        try {
-            n_vertices = stoi(line);
-            size = n_vertices;
-            adj.resize(size, vector<int>(size, 0));
-
-            for (int i = 0; i < size; ++i) {
-                if (getline(file, line)) {
-                    stringstream ss(line);
-                    int val;
-                    for (int j = 0; j < size; ++j) {
-                        if (ss >> val) {
-                            adj[i][j] = val;
-                        }
-                    }
-                }
-            }
-        }
-        catch (...) {
-            cerr << "Error parsing graph data" << endl;
-            size = 0;
-        }
+bool Graph::loadPair(const string& filename, Graph& G, Graph& H) {
+    STATS_TIMER(GraphLoading);
+    if (GraphFile::isEdgeList(filename)) {
+        GraphFile::EdgeList g, h;
+        if (!GraphFile::loadEdgeList(filename, g, h)) return false;
+        G = fromEdges(g.vertices, g.edges);
+        H = fromEdges(h.vertices, h.edges);
+        return true;
     }
-    file.close();
+    BitMatrix g, h;
+    if (!GraphFile::load(filename, g, h)) return false;
+    G = Graph(std::move(g));
+    H = Graph(std::move(h));
+    return true;
 }
 
 void Graph::resize(int new_size) {
     if (new_size > size) {
-        for (auto& row : adj) {
-            row.resize(new_size, 0);
+        if (sparse) {
+            out.grow(new_size);
+            in.grow(new_size);
+            outAdded.resize(new_size);
+            inAdded.resize(new_size);
+        }
+        else {
+            adj.resize(new_size, new_size);
         }
-        adj.resize(new_size, vector<int>(new_size, 0));
         size = new_size;
     }
 }
 
+bool Graph::sparseHasEdge(int u, int v) const {
+    const vector<int>& added = outAdded[u];
+    return out.contains(u, v) || find(added.begin(), added.end(), v) != added.end();
+}
+
+void Graph::addEdge(int u, int v) {
+    if (!sparse) {
+        adj.set(u, v);
+        return;
+    }
+    if (sparseHasEdge(u, v)) return;
+    outAdded[u].push_back(v);
+    inAdded[v].push_back(u);
+    addedEdges++;
+}
+
+void Graph::removeEdge(int u, int v) {
+    if (!sparse) {
+        adj.reset(u, v);
+        return;
+    }
+    // Loaded edges are removed from the compressed arrays in O(E).
+    if (out.erase(u, v)) {
+        in.erase(v, u);
+        return;
+    }
+    auto it = find(outAdded[u].begin(), outAdded[u].end(), v);
+    if (it == outAdded[u].end()) return;
+    outAdded[u].erase(it);
+    inAdded[v].erase(find(inAdded[v].begin(), inAdded[v].end(), u));
+    addedEdges--;
+}
+
+int Graph::outDegree(int u) const {
+    if (!sparse) return adj.rowCount(u);
+    return out.degree(u) + static_cast<int>(outAdded[u].size());
+}
+
 void Graph::print() const {
 
     for (int i = 0; i < size; ++i) {
         for (int j = 0; j < size; ++j) {
-            cout << adj[i][j] << " ";
+            cout << hasEdge(i, j) << " ";
         }
         cout << endl;
     }
 }
 
 int Graph::edgeCount() const {
+    if (sparse) return static_cast<int>(out.edgeCount()) + addedEdges;
+    return static_cast<int>(adj.count());
+}
+
+int Graph::inDegree(int v) const {
+    if (sparse) return in.degree(v) + static_cast<int>(inAdded[v].size());
     int cnt = 0;
-    for (int i = 0; i < size; ++i)
-        for (int j = 0; j < size; ++j)
-            if (adj[i][j] != 0) cnt++;
+    forEachInNeighbor(v, [&](int) { cnt++; });
     return cnt;
 }
 
@@ -146,7 +194,7 @@ void Graph::printHighlighted(const Graph& other) const {
     auto getCell = [&](const Graph& g, int i, int j) -> int {
         if (i < 0 || j < 0) return 0;
         if (i >= g.size || j >= g.size) return 0;
-        return g.adj[i][j];
+        return g.hasEdge(i, j) ? 1 : 0;
         };
 
     for (int i = 0; i < n; ++i) {
@@ -194,15 +242,13 @@ int Graph::DistanceMetric(const Graph& other, const vector<int>& mapping) const
     int n = this->size;
 
     for (int uG = 0; uG < n; ++uG) {
-        for (int vG = 0; vG < n; ++vG) {
-            if (this->adj[uG][vG] > 0) {
-                int uH = mapping[uG];
-                int vH = mapping[vG];
-                if ((this->adj[uG][vG] > 0) != (other.adj[uH][vH] > 0)) {
-                    cost++; // Counts if A has it and B doesn't, OR if B has it and A doesn't
-                }
+        const int uH = mapping[uG];
+        forEachOutNeighbor(uG, [&](int vG) {
+            int vH = mapping[vG];
+            if (!other.hasEdge(uH, vH)) {
+                cost++; // Counts if A has it and B doesn't
             }
-        }
+        });
     }
 
     // Vertex Difference
@@ -220,70 +266,25 @@ int Graph::DistanceMetric(const Graph& other, const vector<int>& mapping) const
     return cost;
 }
 
-pair<vector<int>, int> Graph::FindBestMapping(const Graph& target) const {
-    vector<int> mapping(size, -1);
-    vector<bool> usedH(target.size, false);
-
-    function<pair<vector<int>, int>(int)> solve = [&](int vG) -> pair<vector<int>, int> {
-        if (vG == this->size) {
-            int distance = this->ComputeDistance(target, mapping);
-            return {mapping, distance};
-        }
-
-        int bestDistance = INT_MAX;
-        vector<int> bestMapping;
-
-        for (int vH = 0; vH < target.size; ++vH) {
-            if (!usedH[vH]) {
-                mapping[vG] = vH;
-                usedH[vH] = true;
-
-                auto candidate = solve(vG + 1);
-                if (candidate.second < bestDistance) {
-                    bestDistance = candidate.second;
-                    bestMapping = candidate.first;
-                }
-
-                usedH[vH] = false;
-                mapping[vG] = -1;
-            }
-        }
-
-        return {bestMapping, bestDistance};
-    };
-
-    return solve(0);
-}
-
-
-
-vector<int> computeDegrees(const vector<vector<int>>& adj) {
-    int n = adj.size();
-    vector<int> degrees(n, 0);
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            degrees[i] += adj[i][j];
-        }
+pair<vector<int>, int> Graph::FindBestMapping(const Graph& target, SearchBudget* budget, bool* complete,
+                                              bool assignmentBound) const {
+    // Branch and bound over partial extension costs; returns the same optimum as
+    // enumerating every injective mapping and scoring it with ComputeDistance.
+    // The search works on bit-matrix rows, so sparse graphs are densified first.
+    if (sparse || target.sparse) {
+        return toDense().FindBestMapping(target.toDense(), budget, complete, assignmentBound);
     }
-    return degrees;
-}
-
-static int evaluateMapping(const Graph& G, const Graph& H, const vector<int>& mapping) {
-    int edgesNeeded = 0;
-    for (int i = 0; i < G.size; ++i) {
-        for (int j = 0; j < G.size; ++j) {
-            if (G.adj[i][j] == 1) {
-                int hi = mapping[i];
-                int hj = mapping[j];
-                if (H.adj[hi][hj] == 0) {
-                    edgesNeeded++;
-                }
-            }
-        }
+    ExactSearch search(*this, target, budget, assignmentBound);
+    ExactSearch::Result best = search.run();
+    if (complete) *complete = best.complete;
+    if (best.mapping.size() != static_cast<size_t>(size)) {
+        return { {}, INT_MAX };
     }
-    return edgesNeeded;
+    return { best.mapping, this->ComputeDistance(target, best.mapping) };
 }
 
+
+
 pair<bool, vector<int>> Graph::hungarianMappingOne(const Graph& G, const Graph& H) {
     vector<bool> usedH(H.size, false);
     return hungarianMappingOne(G, H, usedH);
@@ -303,51 +304,10 @@ pair<bool, vector<int>> Graph::hungarianMappingOne(const Graph& G, const Graph&
         return { false, {} };
     }
 
-    HungarianAlgorithm hungarian(m);
-
-    vector<int> degG = computeDegrees(G.adj);
-    vector<int> degH = computeDegrees(H.adj);
-    const int FORBIDDEN = 1'000'000;
-
-    for (int i = 0; i < m; ++i) {
-        for (int j = 0; j < m; ++j) {
-            if (i < n) {
-                if (usedH[j]) {
-                    hungarian.setCost(i, j, FORBIDDEN);
-                }
-                else {
-                    int cost = 0;
-
-                    for (int k = 0; k < n; ++k) {
-                        if (i != k) {
-                            if (G.adj[i][k] == 1) {
-                                int outDegreeH = 0;
-                                for (int l = 0; l < m; ++l) {
-                                    if (H.adj[j][l] == 1) outDegreeH++;
-                                }
-                                if (outDegreeH == 0) cost += 20;
-                            }
-                            if (G.adj[k][i] == 1) {
-                                int inDegreeH = 0;
-                                for (int l = 0; l < m; ++l) {
-                                    if (H.adj[l][j] == 1) inDegreeH++;
-                                }
-                                if (inDegreeH == 0) cost += 20;
-                            }
-                        }
-                    }
-
-                    cost += abs(degG[i] - degH[j]);
-                    cost += (i + j) / 10;
-
-                    hungarian.setCost(i, j, cost + 1);
-                }
-            }
-            else {
-                hungarian.setCost(i, j, 0);
-            }
-        }
-    }
+    // Rectangular n x m assignment: unused H vertices simply stay unassigned.
+    HungarianAlgorithm hungarian(n, m);
+    CostMatrixBuilder costs(G, H);
+    costs.build(hungarian.row(0), m, &usedH);
 
     vector<int> assignment = hungarian.findMinCostAssignment();
     vector<int> mapping(n);
@@ -3,26 +3,109 @@
 #include <vector>
 #include <string>
 #include <utility>
+#include "BitMatrix.h"
+#include "CsrAdjacency.h"
 
+class SearchBudget;
+
+// A directed graph stored either densely (adj, a bit matrix) or sparsely (CSR
+// out-neighbours plus CSC in-neighbours, O(V + E) memory; see fromEdges). The
+// sparse form keeps edges added later in small per-vertex lists. Code that
+// walks neighbours through forEachOutNeighbor / forEachInNeighbor and queries
+// through hasEdge / addEdge / degrees works with both; adj is only valid in
+// the dense form.
 class Graph {
 public:
     int size;
-    std::vector<std::vector<int>> adj;
+    BitMatrix adj;
 
     Graph();
     Graph(int n);
+    explicit Graph(const std::vector<std::vector<int>>& matrix);
+    explicit Graph(BitMatrix matrix);
     Graph(const std::string& filename, bool first_graph);
+
+    // Sparse graph on n vertices; (from, to) pairs, duplicates are dropped.
+    static Graph fromEdges(int n, const std::vector<std::pair<int, int>>& edges);
+    bool isSparse() const { return sparse; }
+    // Dense copy of this graph (a plain copy if it already is dense).
+    Graph toDense() const;
+
+    // Loads G and H from one input file (text or binary, see GraphFile) in a
+    // single pass; a binary file is mapped and not copied. Edge-list files give
+    // sparse graphs.
+    static bool loadPair(const std::string& filename, Graph& G, Graph& H);
     
+    bool hasEdge(int u, int v) const { return sparse ? sparseHasEdge(u, v) : adj.test(u, v); }
+    void addEdge(int u, int v);
+    void removeEdge(int u, int v);
+    int outDegree(int u) const;
+    int inDegree(int v) const;
+
+    // Visits every w with an edge u -> w (dense: lowest first).
+    template <class Fn> void forEachOutNeighbor(int u, Fn&& fn) const;
+    // Visits every w with an edge w -> v (dense: a column scan, O(size)).
+    template <class Fn> void forEachInNeighbor(int v, Fn&& fn) const;
+
     void resize(int new_size);
     void print() const;
     void printHighlighted(const Graph& other) const;
     int ComputeDistance(const Graph& other, const std::vector<int>& mapping) const;
     int DistanceMetric(const Graph& other, const std::vector<int>& mapping) const;
-    std::pair<std::vector<int>, int> FindBestMapping(const Graph& target) const;
+    // Optimal mapping and its distance ({}, INT_MAX if none). With a budget the
+    // search may stop early; *complete then tells whether it is proven optimal.
+    // assignmentBound selects ExactSearch's assignment lower bound.
+    std::pair<std::vector<int>, int> FindBestMapping(const Graph& target, SearchBudget* budget = nullptr,
+                                                     bool* complete = nullptr, bool assignmentBound = true) const;
     int edgeCount() const;
     static std::pair<bool, std::vector<int>> hungarianMappingOne(const Graph& G, const Graph& H);
     static std::pair<bool, std::vector<int>> hungarianMappingOne(const Graph& G, const Graph& H, const std::vector<bool>& usedH);
     
 private:
     void loadFromFile(const std::string& filename, bool first_graph);
-};
\ No newline at end of file
+    bool sparseHasEdge(int u, int v) const;
+
+    bool sparse = false;
+    CsrAdjacency out;                           // sparse: loaded edges by source
+    CsrAdjacency in;                            // sparse: loaded edges by target
+    std::vector<std::vector<int>> outAdded;     // sparse: edges added since, by source
+    std::vector<std::vector<int>> inAdded;      // sparse: edges added since, by target
+    int addedEdges = 0;
+};
+
+// Visits every column j with bit (row, j) set, lowest first, one 64-bit word at a time.
+template <class Fn>
+inline void forEachSetBit(const BitMatrix& m, int row, Fn&& fn) {
+    const uint64_t* r = m.row(row);
+    const int words = m.usedWords();
+    for (int w = 0; w < words; ++w) {
+        uint64_t bits = r[w];
+        while (bits) {
+            fn(w * BitMatrix::BITS_PER_WORD + countTrailingZeros64(bits));
+            bits &= bits - 1;
+        }
+    }
+}
+
+template <class Fn>
+inline void Graph::forEachOutNeighbor(int u, Fn&& fn) const {
+    if (!sparse) {
+        forEachSetBit(adj, u, fn);
+        return;
+    }
+    for (const int* w = out.begin(u); w != out.end(u); ++w) fn(*w);
+    for (int w : outAdded[u]) fn(w);
+}
+
+template <class Fn>
+inline void Graph::forEachInNeighbor(int v, Fn&& fn) const {
+    if (!sparse) {
+        const int word = v >> 6;
+        const uint64_t bit = uint64_t(1) << (v & 63);
+        for (int w = 0; w < size; ++w)
+            if (adj.row(w)[word] & bit) fn(w);
+        return;
+    }
+    for (const int* w = in.begin(v); w != in.end(v); ++w) fn(*w);
+    for (int w : inAdded[v]) fn(w);
+}
@@ -0,0 +1,370 @@
+#include "GraphFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "MappedFile.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+const char GraphFile::MAGIC[8] = { 'G', 'M', 'E', 'G', 'R', 'A', 'P', 'H' };
+
+static_assert(sizeof(GraphFile::Header) == 64, "binary graph header must stay 64 bytes");
+
+static const size_t LINE_BYTES = BitMatrix::WORDS_PER_LINE * sizeof(uint64_t);
+
+static uint64_t alignToLine(uint64_t offset) {
+    return (offset + LINE_BYTES - 1) / LINE_BYTES * LINE_BYTES;
+}
+
+// Whether every row of an n x n matrix keeps its bits past column n, padding
+// words included, at zero, as BitMatrix::view requires.
+static bool paddingIsClear(const uint64_t* rows, int n, int stride) {
+    const int used = (n + BitMatrix::BITS_PER_WORD - 1) / BitMatrix::BITS_PER_WORD;
+    const int tailBits = n % BitMatrix::BITS_PER_WORD;
+    const uint64_t tailMask = tailBits == 0 ? 0 : ~uint64_t(0) << tailBits;
+    for (int i = 0; i < n; ++i) {
+        const uint64_t* row = rows + static_cast<size_t>(i) * stride;
+        if (used > 0 && (row[used - 1] & tailMask) != 0) return false;
+        for (int w = used; w < stride; ++w) {
+            if (row[w] != 0) return false;
+        }
+    }
+    return true;
+}
+
+bool GraphFile::load(const string& path, BitMatrix& G, BitMatrix& H) {
+    return isBinary(path) ? loadBinary(path, G, H) : loadText(path, G, H);
+}
+
+bool GraphFile::isBinary(const string& path) {
+    ifstream file(path, ios::binary);
+    char magic[sizeof(MAGIC)];
+    return file.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool GraphFile::loadBinary(const string& path, BitMatrix& G, BitMatrix& H) {
+    shared_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file) {
+        cerr << "Error: Could not open file " << path << endl;
+        return false;
+    }
+    if (file->size() < sizeof(Header)) {
+        cerr << "Error: " << path << " is too short for a binary graph header" << endl;
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, file->data(), sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        cerr << "Error: " << path << " is not a version " << VERSION << " binary graph file" << endl;
+        return false;
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        cerr << "Error: " << path << " was written on a machine with a different byte order" << endl;
+        return false;
+    }
+    if (header.graphCount != 2) {
+        cerr << "Error: " << path << " holds " << header.graphCount << " graphs, expected 2" << endl;
+        return false;
+    }
+
+    BitMatrix* out[2] = { &G, &H };
+    for (int g = 0; g < 2; ++g) {
+        const int n = static_cast<int>(header.size[g]);
+        const uint64_t bytes = static_cast<uint64_t>(header.size[g]) * header.stride[g] * sizeof(uint64_t);
+        if (header.size[g] > static_cast<uint32_t>(INT32_MAX) ||
+            header.stride[g] != static_cast<uint32_t>(BitMatrix::strideFor(n)) ||
+            header.offset[g] % LINE_BYTES != 0 ||
+            header.offset[g] > file->size() || bytes > file->size() - header.offset[g]) {
+            cerr << "Error: " << path << " has an invalid layout for graph " << (g == 0 ? "G" : "H") << endl;
+            return false;
+        }
+        uint64_t* rows = reinterpret_cast<uint64_t*>(file->data() + header.offset[g]);
+        if (!paddingIsClear(rows, n, static_cast<int>(header.stride[g]))) {
+            cerr << "Error: " << path << " has bits set past the last column of graph " << (g == 0 ? "G" : "H") << endl;
+            return false;
+        }
+        *out[g] = BitMatrix::view(n, n, rows, file);
+    }
+    return true;
+}
+
+bool GraphFile::saveBinary(const string& path, const BitMatrix& G, const BitMatrix& H) {
+    ofstream file(path, ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        cerr << "Error: Could not create file " << path << endl;
+        return false;
+    }
+
+    const BitMatrix* graphs[2] = { &G, &H };
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.graphCount = 2;
+    uint64_t offset = alignToLine(sizeof(Header));
+    for (int g = 0; g < 2; ++g) {
+        header.size[g] = static_cast<uint32_t>(graphs[g]->rows());
+        header.stride[g] = static_cast<uint32_t>(graphs[g]->stride());
+        header.offset[g] = offset;
+        offset = alignToLine(offset + static_cast<uint64_t>(graphs[g]->rows()) * graphs[g]->stride() * sizeof(uint64_t));
+    }
+
+    // Rows go out exactly as they sit in memory, padding included.
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t written = sizeof(header);
+    const char zeros[LINE_BYTES] = {};
+    for (int g = 0; g < 2; ++g) {
+        file.write(zeros, static_cast<streamsize>(header.offset[g] - written));
+        const uint64_t bytes = static_cast<uint64_t>(graphs[g]->rows()) * graphs[g]->stride() * sizeof(uint64_t);
+        if (bytes > 0) {
+            file.write(reinterpret_cast<const char*>(graphs[g]->row(0)), static_cast<streamsize>(bytes));
+        }
+        written = header.offset[g] + bytes;
+    }
+
+    if (!file) {
+        cerr << "Error: Could not write file " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+namespace {
+    // Cursor over the mapped text with line tracking for error messages.
+    struct TextCursor {
+        const char* p;
+        const char* end;
+        long long line;
+
+        bool atEnd() const { return p >= end; }
+        void skipBlanks() {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+        }
+        // Consumes the rest of the current line, which must be blank.
+        bool endLine() {
+            skipBlanks();
+            if (p >= end) return true;
+            if (*p != '\n') return false;
+            ++p;
+            ++line;
+            return true;
+        }
+        void skipEmptyLines() {
+            while (true) {
+                const char* q = p;
+                while (q < end && (*q == ' ' || *q == '\t' || *q == '\r')) ++q;
+                if (q < end && *q == '\n') {
+                    p = q + 1;
+                    ++line;
+                }
+                else {
+                    return;
+                }
+            }
+        }
+    };
+
+    bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    // Packs the even bits of a 16-bit movemask (one per "d " pair) into 8 bits.
+    inline uint32_t evenBits(uint32_t mask) {
+        mask &= 0x5555;
+        mask = (mask | (mask >> 1)) & 0x3333;
+        mask = (mask | (mask >> 2)) & 0x0f0f;
+        return (mask | (mask >> 4)) & 0x00ff;
+    }
+
+    // Parses the n values of one matrix row into out. Rows written as single
+    // 0/1 digits separated by single spaces (what the generator produces) go
+    // through 16 bytes = 8 cells at a time; anything else, e.g. other integers
+    // or tabs, falls back to a token scanner. Any nonzero value is an edge.
+    // Returns the number of values on the line, or -1 on a malformed token.
+    long long parseRow(TextCursor& c, int n, uint64_t* out) {
+        long long j = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i zero = _mm_set1_epi8('0');
+        const __m128i one = _mm_set1_epi8('1');
+        const __m128i space = _mm_set1_epi8(' ');
+        // The 16th byte must still be a separator, so stop 8 cells before the end.
+        while (j + 8 < n && c.end - c.p >= 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c.p));
+            const uint32_t ones = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, one)));
+            const uint32_t digits = ones | static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)));
+            const uint32_t spaces = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, space)));
+            if ((digits & 0x5555) != 0x5555 || (spaces & 0xaaaa) != 0xaaaa) break;
+            // j is a multiple of 8 here, so the byte never straddles two words.
+            out[j >> 6] |= static_cast<uint64_t>(evenBits(ones)) << (j & 63);
+            c.p += 16;
+            j += 8;
+        }
+#endif
+        while (true) {
+            c.skipBlanks();
+            if (c.atEnd() || *c.p == '\n') return j;
+            const char* token = c.p;
+            if (*c.p == '-' || *c.p == '+') ++c.p;
+            if (c.atEnd() || !isDigit(*c.p)) {
+                c.p = token;
+                return -1;
+            }
+            bool nonzero = false;
+            while (!c.atEnd() && isDigit(*c.p)) {
+                nonzero |= *c.p != '0';
+                ++c.p;
+            }
+            if (!c.atEnd() && *c.p != ' ' && *c.p != '\t' && *c.p != '\r' && *c.p != '\n') {
+                c.p = token;
+                return -1;
+            }
+            if (nonzero && j < n) out[j >> 6] |= uint64_t(1) << (j & 63);
+            ++j;
+        }
+    }
+
+    // Reads one unsigned decimal of at most limit from the current line.
+    bool readNumber(TextCursor& c, long long limit, long long& value) {
+        c.skipBlanks();
+        value = 0;
+        bool digits = false;
+        while (!c.atEnd() && isDigit(*c.p)) {
+            const int digit = *c.p++ - '0';
+            if (value > (limit - digit) / 10) return false;
+            value = value * 10 + digit;
+            digits = true;
+        }
+        return digits;
+    }
+}
+
+bool GraphFile::loadText(const string& path, BitMatrix& G, BitMatrix& H) {
+    shared_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file) {
+        cerr << "Error: Could not open file " << path << endl;
+        return false;
+    }
+    file->adviseSequential();
+
+    // Both graphs in one pass over the mapping: a size line, then exactly
+    // size lines of size values each.
+    TextCursor c{ file->data(), file->data() + file->size(), 1 };
+    BitMatrix* out[2] = { &G, &H };
+    const char* names[2] = { "G", "H" };
+    for (int g = 0; g < 2; ++g) {
+        c.skipEmptyLines();
+        c.skipBlanks();
+        long long n = 0;
+        bool digits = false;
+        while (!c.atEnd() && isDigit(*c.p) && n <= INT32_MAX) {
+            n = n * 10 + (*c.p++ - '0');
+            digits = true;
+        }
+        if (!digits || n > INT32_MAX || !c.endLine()) {
+            cerr << "Error: " << path << ":" << c.line << ": expected the vertex count of " << names[g] << endl;
+            return false;
+        }
+
+        // Every row takes at least 2 * size - 1 bytes ("0 0 ... 0"), so a
+        // corrupt count is caught here rather than by the allocation.
+        if (n > 0 && (c.end - c.p) / n < 2 * n - 1) {
+            cerr << "Error: " << path << ": " << names[g] << " has " << n
+                 << " vertices, more rows than the rest of the file holds" << endl;
+            return false;
+        }
+
+        const int size = static_cast<int>(n);
+        *out[g] = BitMatrix(size, size);
+        for (int i = 0; i < size; ++i) {
+            if (c.atEnd()) {
+                cerr << "Error: " << path << ": " << names[g] << " has " << i << " rows, expected " << size << endl;
+                return false;
+            }
+            const long long values = parseRow(c, size, out[g]->row(i));
+            if (values < 0) {
+                cerr << "Error: " << path << ":" << c.line << ": invalid value in row " << i << " of " << names[g] << endl;
+                return false;
+            }
+            if (values != size) {
+                cerr << "Error: " << path << ":" << c.line << ": row " << i << " of " << names[g] << " has "
+                     << values << " values, expected " << size << endl;
+                return false;
+            }
+            c.endLine();
+        }
+    }
+    return true;
+}
+
+bool GraphFile::isEdgeList(const string& path) {
+    ifstream file(path, ios::binary);
+    string word;
+    return (file >> word) && word == "edges";
+}
+
+bool GraphFile::loadEdgeList(const string& path, EdgeList& G, EdgeList& H) {
+    shared_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file) {
+        cerr << "Error: Could not open file " << path << endl;
+        return false;
+    }
+    file->adviseSequential();
+
+    TextCursor c{ file->data(), file->data() + file->size(), 1 };
+    c.skipEmptyLines();
+    c.skipBlanks();
+    if (c.end - c.p < 5 || memcmp(c.p, "edges", 5) != 0 || (c.p += 5, !c.endLine())) {
+        cerr << "Error: " << path << ":" << c.line << ": expected the \"edges\" header line" << endl;
+        return false;
+    }
+
+    EdgeList* out[2] = { &G, &H };
+    const char* names[2] = { "G", "H" };
+    for (int g = 0; g < 2; ++g) {
+        c.skipEmptyLines();
+        long long n = 0, m = 0;
+        if (!readNumber(c, INT32_MAX, n) || !readNumber(c, INT64_MAX / 10, m) || !c.endLine()) {
+            cerr << "Error: " << path << ":" << c.line << ": expected the vertex and edge counts of " << names[g] << endl;
+            return false;
+        }
+        if (n > MAX_EDGE_LIST_VERTICES) {
+            cerr << "Error: " << path << ": " << names[g] << " has " << n
+                 << " vertices, more than the " << MAX_EDGE_LIST_VERTICES << " an edge list may have" << endl;
+            return false;
+        }
+
+        out[g]->vertices = static_cast<int>(n);
+        out[g]->edges.clear();
+        // Every edge line takes at least four bytes ("u v\n"), which bounds the
+        // reservation for a corrupt count.
+        out[g]->edges.reserve(static_cast<size_t>(min<long long>(m, (c.end - c.p) / 4 + 1)));
+        for (long long e = 0; e < m; ++e) {
+            c.skipEmptyLines();
+            if (c.atEnd()) {
+                cerr << "Error: " << path << ": " << names[g] << " has " << e << " edges, expected " << m << endl;
+                return false;
+            }
+            long long u = 0, v = 0;
+            if (!readNumber(c, INT32_MAX, u) || !readNumber(c, INT32_MAX, v)) {
+                cerr << "Error: " << path << ":" << c.line << ": expected an edge \"<from> <to>\" of " << names[g] << endl;
+                return false;
+            }
+            if (u >= n || v >= n) {
+                cerr << "Error: " << path << ":" << c.line << ": edge " << u << " " << v << " of " << names[g]
+                     << " is outside its " << n << " vertices" << endl;
+                return false;
+            }
+            if (!c.endLine()) {
+                cerr << "Error: " << path << ":" << c.line << ": unexpected text after the edge of " << names[g] << endl;
+                return false;
+            }
+            out[g]->edges.emplace_back(static_cast<int>(u), static_cast<int>(v));
+        }
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "BitMatrix.h"
+
+// Input files holding the pattern G followed by the target H, as adjacency
+// matrices, in one of two formats:
+//
+// Text:   the format described in Doc/Instruction.txt (size line, then one line
+//         of space separated 0/1 values per row, for G and then for H).
+// Binary: a 64-byte Header followed by the matrices of G and H as bit-packed rows
+//         in exactly the BitMatrix layout (stride of whole 64-byte lines, zero
+//         padding), each starting at a 64-byte aligned offset. loadBinary maps the
+//         file and hands out views into it, so nothing is parsed or copied.
+//
+// Sparse graphs can instead be given as edge lists (loadEdgeList): a first line
+// "edges", then for G and then for H a line "<vertices> <edges>" followed by one
+// "<from> <to>" line per directed edge, vertices numbered from 0.
+class GraphFile {
+public:
+    static const char MAGIC[8];
+    static const uint32_t VERSION = 1;
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;     // BYTE_ORDER_MARK as stored by the writing machine
+        uint32_t flags;         // reserved, 0
+        uint32_t graphCount;    // 2: G, then H
+        uint32_t size[2];       // vertices
+        uint32_t stride[2];     // 64-bit words per row
+        uint64_t offset[2];     // byte offset of row 0 from the start of the file
+        uint8_t reserved[8];
+    };
+
+    // Reads either format, recognised by the magic at the start of the file.
+    // Errors are reported on stderr and leave false.
+    static bool load(const std::string& path, BitMatrix& G, BitMatrix& H);
+
+    static bool isBinary(const std::string& path);
+    static bool loadBinary(const std::string& path, BitMatrix& G, BitMatrix& H);
+    static bool saveBinary(const std::string& path, const BitMatrix& G, const BitMatrix& H);
+
+    static bool loadText(const std::string& path, BitMatrix& G, BitMatrix& H);
+
+    // Isolated vertices take no bytes in an edge list, so its vertex count is
+    // bounded by this instead (about 1 GB of per-vertex state in Graph).
+    static const int MAX_EDGE_LIST_VERTICES = 1 << 24;
+
+    struct EdgeList {
+        int vertices = 0;
+        std::vector<std::pair<int, int>> edges;   // (from, to), duplicates possible
+    };
+
+    static bool isEdgeList(const std::string& path);
+    static bool loadEdgeList(const std::string& path, EdgeList& G, EdgeList& H);
+};
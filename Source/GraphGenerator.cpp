@@ -5,6 +5,7 @@
 #include <ctime>
 #include <algorithm>
 #include <numeric>
+#include "GraphFile.h"
 
 using namespace std;
 
@@ -80,3 +81,20 @@ void GraphGenerator::saveGraphsToFile(const string& filename,
 
     file.close();
 }
+
+static BitMatrix toBitMatrix(const vector<vector<int>>& adj) {
+    const int n = static_cast<int>(adj.size());
+    BitMatrix bits(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n && j < static_cast<int>(adj[i].size()); ++j) {
+            if (adj[i][j] != 0) bits.set(i, j);
+        }
+    }
+    return bits;
+}
+
+void GraphGenerator::saveGraphsToBinaryFile(const string& filename,
+                                          const vector<vector<int>>& G,
+                                          const vector<vector<int>>& H) {
+    GraphFile::saveBinary(filename, toBitMatrix(G), toBitMatrix(H));
+}
@@ -9,4 +9,8 @@ public:
     static void saveGraphsToFile(const std::string& filename,
                                 const std::vector<std::vector<int>>& G,
                                 const std::vector<std::vector<int>>& H);
+    // Same graphs in the binary format of GraphFile (bit-packed rows, mappable).
+    static void saveGraphsToBinaryFile(const std::string& filename,
+                                      const std::vector<std::vector<int>>& G,
+                                      const std::vector<std::vector<int>>& H);
 };
\ No newline at end of file
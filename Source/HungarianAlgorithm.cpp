@@ -1,80 +1,292 @@
 #include "HungarianAlgorithm.h"
-#include <climits>
+#include <algorithm>
+#include <limits>
 #include <vector>
+#include "Stats.h"
 
 using namespace std;
 
-HungarianAlgorithm::HungarianAlgorithm(int size) : n(size) {
-    cost_matrix.assign(n, vector<int>(n, 0));
+template <class Cost>
+BasicHungarianAlgorithm<Cost>::BasicHungarianAlgorithm(int size) : BasicHungarianAlgorithm(size, size) {}
+
+template <class Cost>
+BasicHungarianAlgorithm<Cost>::BasicHungarianAlgorithm(int rows, int cols)
+    : n(rows), m(cols), warm(false),
+      relax(relaxKernel<Cost>(activeSimdLevel())), shift(shiftKernel<Cost>(activeSimdLevel())) {
+    cost_matrix.assign(static_cast<size_t>(n) * m, Cost(0));
+}
+
+template <class Cost>
+void BasicHungarianAlgorithm<Cost>::noteChange(int i, int j) {
+    if (!warm) return;
+    // Past a quarter of the matrix a cold solve is cheaper than the repair.
+    if (changed.size() > static_cast<size_t>(n) * m / 4) {
+        warm = false;
+        changed.clear();
+        return;
+    }
+    changed.emplace_back(i, j);
+}
+
+template <class Cost>
+void BasicHungarianAlgorithm<Cost>::setCost(int i, int j, Cost cost) {
+    Cost& cell = cost_matrix[static_cast<size_t>(i) * m + j];
+    if (cell != cost) {
+        cell = cost;
+        noteChange(i, j);
+    }
 }
 
-void HungarianAlgorithm::setCost(int i, int j, int cost) {
-    cost_matrix[i][j] = cost;
+template <class Cost>
+void BasicHungarianAlgorithm<Cost>::updateCosts(const Cost* rows, int count) {
+    for (int i = 0; i < count; ++i) {
+        Cost* dst = cost_matrix.data() + static_cast<size_t>(i) * m;
+        const Cost* src = rows + static_cast<size_t>(i) * m;
+        for (int j = 0; j < m; ++j) {
+            if (dst[j] != src[j]) {
+                dst[j] = src[j];
+                noteChange(i, j);
+            }
+        }
+    }
 }
 
-vector<int> HungarianAlgorithm::findMinCostAssignment() {
+template <class Cost>
+void BasicHungarianAlgorithm<Cost>::shiftColumn(int j, Cost delta) {
+    for (int i = 0; i < n; ++i) {
+        cost_matrix[static_cast<size_t>(i) * m + j] += delta;
+    }
+    if (!warm) return;
+    const int col = j + 1;
+    if (delta < Cost(0)) {
+        // Every reduced cost of the column stays as it was. Only a free column
+        // is left wrong, below v = 0, until the next solve matches it.
+        v[col] += delta;
+        if (p[col] == 0) pending.push_back(col);
+        return;
+    }
+    // v may rise no further than 0; a matched pair left slack loses its row.
+    const Cost target = v[col] + delta;
+    v[col] = min(target, Cost(0));
+    if (p[col] != 0 && v[col] != target) {
+        noteChange(p[col] - 1, j);
+    }
+}
+
+template <class Cost>
+vector<int> BasicHungarianAlgorithm<Cost>::findMinCostAssignment() {
     return solve();
 }
 
-vector<int> HungarianAlgorithm::solve() {
-    // Kuhn-Munkres algorithm for minimum cost bipartite matching
-    vector<vector<int>> matrix = cost_matrix;
-    vector<int> u(n + 1), v(n + 1), p(n + 1), way(n + 1);
+template <class Cost>
+void BasicHungarianAlgorithm<Cost>::repair() {
+    // Restore dual feasibility (u[i] + v[j] <= c[i][j]) and drop matched pairs
+    // that are no longer tight; those rows are augmented again by solve().
+    vector<int> rowMatch(n + 1, 0);
+    for (int j = 1; j <= m; ++j) {
+        if (p[j] != 0) rowMatch[p[j]] = j;
+    }
 
-    for (int i = 1; i <= n; ++i) {
-        // Process each row to build optimal assignment
-        p[0] = i;
-        int j0 = 0;
-        vector<int> minv(n + 1, INT_MAX);
-        vector<bool> used(n + 1, false);
-
-        do {
-            // Find augmenting path using modified Dijkstra
-            used[j0] = true;
-            int i0 = p[j0], delta = INT_MAX, j1;
-
-            // Update reduced costs for all unmatched columns
-            for (int j = 1; j <= n; ++j) {
-                if (!used[j]) {
-                    int cur = matrix[i0 - 1][j - 1] - u[i0] - v[j];
-                    if (cur < minv[j]) {
-                        minv[j] = cur;
-                        way[j] = j0;
-                    }
-                    if (minv[j] < delta) {
-                        delta = minv[j];
-                        j1 = j;
-                    }
-                }
+    vector<int> freed;
+    auto unmatchRow = [&](int i) {
+        const int j = rowMatch[i];
+        p[j] = 0;
+        rowMatch[i] = 0;
+        freed.push_back(j);
+    };
+    auto lowerRow = [&](int i, int j) {
+        if (u[i] + v[j] > cost(i, j)) {
+            u[i] = cost(i, j) - v[j];
+        }
+        const int mj = rowMatch[i];
+        if (mj != 0 && u[i] + v[mj] != cost(i, mj)) {
+            unmatchRow(i);
+        }
+    };
+
+    for (const auto& cell : changed) {
+        lowerRow(cell.first + 1, cell.second + 1);
+    }
+    changed.clear();
+
+    // With surplus columns a freed column must return to v = 0; rows that this
+    // makes infeasible are lowered and may free their own columns in turn.
+    if (n < m) {
+        while (!freed.empty()) {
+            const int j = freed.back();
+            freed.pop_back();
+            if (p[j] != 0 || v[j] == Cost(0)) continue;
+            v[j] = Cost(0);
+            for (int i = 1; i <= n; ++i) {
+                lowerRow(i, j);
             }
+        }
+    }
+}
+
+template <class Cost>
+void BasicHungarianAlgorithm<Cost>::augment(int i) {
+    // Grow a shortest augmenting path from row i (modified Dijkstra on reduced costs)
+    p[0] = i;
+    int j0 = 0;
+    fill(minv.begin(), minv.end(), numeric_limits<Cost>::max());
+    fill(used.begin(), used.end(), SimdMask<Cost>(0));
+    tree.clear();
 
-            // Update dual variables (potentials)
-            for (int j = 0; j <= n; ++j) {
-                if (used[j]) {
-                    u[p[j]] += delta;
-                    v[j] -= delta;
-                } else {
-                    minv[j] -= delta;
-                }
+    do {
+        used[j0] = ~SimdMask<Cost>(0);
+        tree.push_back(j0);
+        const int i0 = p[j0];
+
+        // Relax every column outside the tree through row i0 and pick the closest
+        int k;
+        const Cost delta = relax(costRow(i0), u[i0], v.data() + 1, minv.data() + 1, way.data() + 1,
+                                 used.data() + 1, j0, m, &k);
+
+        // Update dual variables (potentials); column 0 is the virtual root
+        for (int j : tree) {
+            u[p[j]] += delta;
+        }
+        v[0] -= delta;
+        shift(v.data() + 1, minv.data() + 1, used.data() + 1, delta, m);
+
+        j0 = k + 1;
+    } while (p[j0] != 0);
+
+    // Update assignment along augmenting path
+    do {
+        int j1 = way[j0];
+        p[j0] = p[j1];
+        j0 = j1;
+    } while (j0);
+}
+
+template <class Cost>
+int BasicHungarianAlgorithm<Cost>::pull(int j0) {
+    // Every row is matched and free column j0 has v[j0] < 0. Either v[j0] is
+    // raised back to 0, or j0 is matched by moving rows along j0 - i1 - j1 -
+    // ... - ik - jk, each row i_t leaving j_t for j_(t-1), which frees jk.
+    // This is a Dijkstra from j0 over columns: the step to row i costs the
+    // reduced cost of (i, column), the row leads on to its own column for
+    // free, leaving at column jk costs -v[jk], the rise that returns the freed
+    // column to v = 0, and raising v[j0] instead costs -v[j0].
+    vector<int> colOf(n + 1, 0);
+    for (int j = 1; j <= m; ++j) {
+        if (p[j] != 0) colOf[p[j]] = j;
+    }
+    const Cost inf = numeric_limits<Cost>::max();
+    vector<Cost> dist(n + 1, inf);
+    vector<int> from(n + 1, 0);
+    vector<char> done(n + 1, 0);
+    vector<int> settled;   // rows, in the order they were reached
+
+    Cost best = -v[j0];
+    int exitCol = 0;   // 0: j0 stays free
+    int c = j0;
+    Cost dc = Cost(0);
+    while (true) {
+        for (int i = 1; i <= n; ++i) {
+            if (done[i]) continue;
+            const Cost d = dc + (cost(i, c) - u[i] - v[c]);
+            if (d < dist[i]) {
+                dist[i] = d;
+                from[i] = c;
             }
+        }
+        int next = 0;
+        for (int i = 1; i <= n; ++i) {
+            if (!done[i] && (next == 0 || dist[i] < dist[next])) next = i;
+        }
+        if (next == 0 || !(dist[next] < best)) break;
+        done[next] = 1;
+        settled.push_back(next);
+        c = colOf[next];
+        dc = dist[next];
+        if (dc - v[c] < best) {
+            best = dc - v[c];
+            exitCol = c;
+        }
+    }
+    // Potentials from the distances capped at best keep every reduced cost
+    // non-negative, make the path tight and return v of the column left free
+    // to 0.
+    v[j0] += best;
+    for (int i : settled) {
+        if (dist[i] < best) {
+            u[i] += dist[i] - best;
+            v[colOf[i]] -= dist[i] - best;
+        }
+    }
 
-            j0 = j1;
-        } while (p[j0] != 0);
+    if (exitCol == 0) return static_cast<int>(settled.size());
+    int i = p[exitCol];
+    p[exitCol] = 0;
+    while (true) {
+        const int j = from[i];
+        const int displaced = p[j];
+        p[j] = i;
+        if (j == j0) break;
+        i = displaced;
+    }
+    return static_cast<int>(settled.size());
+}
 
-        // Update assignment along augmenting path
-        do {
-            int j1 = way[j0];
-            p[j0] = p[j1];
-            j0 = j1;
-        } while (j0);
+template <class Cost>
+vector<int> BasicHungarianAlgorithm<Cost>::solve() {
+    // Kuhn-Munkres algorithm for minimum cost bipartite matching
+    STATS_TIMER(HungarianSolve);
+    if (warm) {
+        repair();
     }
+    else {
+        u.assign(n + 1, Cost(0));
+        v.assign(m + 1, Cost(0));
+        p.assign(m + 1, 0);
+        changed.clear();
+        pending.clear();
+    }
+    way.assign(m + 1, 0);
+    minv.resize(m + 1);
+    used.resize(m + 1);
+    tree.reserve(m + 1);
+
+    vector<bool> matched(n + 1, false);
+    for (int j = 1; j <= m; ++j) {
+        matched[p[j]] = true;
+    }
+    long long paths = 0, steps = 0;
+    for (int i = 1; i <= n; ++i) {
+        // Process each row without a match to build optimal assignment
+        if (!matched[i]) {
+            augment(i);
+            paths++;
+            steps += static_cast<long long>(tree.size());
+        }
+    }
+    p[0] = 0;
+    // Lowered free columns that no augmenting path happened to end in.
+    for (int j : pending) {
+        if (p[j] == 0 && v[j] < Cost(0)) {
+            steps += pull(j);
+            paths++;
+        }
+    }
+    pending.clear();
+    STATS_ADD(AugmentingPaths, paths);
+    STATS_ADD(AugmentingPathSteps, steps);
+    warm = true;
 
     // Convert internal representation to result format
-    vector<int> result(n);
-    for (int j = 1; j <= n; ++j) {
+    vector<int> result(n, -1);
+    for (int j = 1; j <= m; ++j) {
         if (p[j] != 0) {
             result[p[j] - 1] = j - 1;
         }
     }
     return result;
 }
+
+template class BasicHungarianAlgorithm<int32_t>;
+template class BasicHungarianAlgorithm<int64_t>;
+template class BasicHungarianAlgorithm<float>;
+template class BasicHungarianAlgorithm<double>;
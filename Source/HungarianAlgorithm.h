@@ -1,17 +1,82 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <utility>
 #include <vector>
+#include "HungarianKernels.h"
 
-class HungarianAlgorithm {
+// Kuhn-Munkres over a rows x cols cost matrix with rows <= cols: every row is
+// assigned a distinct column and surplus columns stay free, in O(rows^2 * cols)
+// time and O(rows * cols) memory. The square constructor is the rows == cols case.
+//
+// The dual potentials (u, v) and the matching survive a solve: when costs are
+// then changed through setCost or updateCosts, the next findMinCostAssignment
+// repairs only the rows and columns touched by the changed cells and
+// re-augments the rows that lost their match, instead of solving from zero.
+// shiftColumn moves a whole column by a constant and takes the shift into the
+// column's potential, so lowering a column never unmatches a row; a free
+// column lowered this way costs one alternating path at most.
+//
+// Cost may be int32_t, int64_t, float or double (instantiated in the .cpp).
+// Costs live in one row-major buffer that is solved in place, all scratch is
+// allocated once per solve, and the column sweep of every augmenting step runs
+// through the widest SIMD kernel the CPU supports (see HungarianKernels.h).
+template <class Cost>
+class BasicHungarianAlgorithm {
 public:
-    HungarianAlgorithm(int size);
-    
-    void setCost(int i, int j, int cost);
+    BasicHungarianAlgorithm(int size);
+    BasicHungarianAlgorithm(int rows, int cols);
+
+    void setCost(int i, int j, Cost cost);
+    // Row i of the row-major cost matrix, for filling whole rows at once.
+    // Writing through it bypasses change tracking, so it drops any warm start.
+    Cost* row(int i) { warm = false; return cost_matrix.data() + static_cast<size_t>(i) * m; }
+    int size() const { return n; }
+    int rows() const { return n; }
+    int cols() const { return m; }
+    // Replaces rows 0..count-1 with a row-major block of count x cols() costs,
+    // remembering which cells differ from the previous ones.
+    void updateCosts(const Cost* rows, int count);
+    // Adds delta to every cost of column j. Warm, a matched column keeps its
+    // row while v[j] can absorb the shift; otherwise only that row is
+    // re-augmented. A free column that is lowered is matched by the next
+    // solve along the cheapest path into it, which frees one other column,
+    // unless staying free is cheaper.
+    void shiftColumn(int j, Cost delta);
+    // result[i] = column assigned to row i.
     std::vector<int> findMinCostAssignment();
-    
+
 private:
-    std::vector<std::vector<int>> cost_matrix;
+    std::vector<Cost> cost_matrix;   // n x m, row-major
     int n;
-    
+    int m;
+
+    // Solver state, 1-based as in the augmenting-path formulation; p[j] is the
+    // row matched to column j (0 = free). Free columns always keep v[j] == 0,
+    // which is what makes a partial (rectangular) assignment optimal.
+    bool warm;
+    std::vector<Cost> u, v;
+    std::vector<int> p, way;
+    std::vector<std::pair<int, int>> changed;
+    std::vector<int> pending;   // free columns left with v[j] < 0 by shiftColumn
+
+    // Per-augmentation scratch, sized once per solve.
+    std::vector<Cost> minv;
+    std::vector<SimdMask<Cost>> used;   // 0 or all ones, see SimdMask
+    std::vector<int> tree;              // columns with used[j] set, in insertion order
+
+    RelaxKernel<Cost> relax;
+    ShiftKernel<Cost> shift;
+
+    const Cost* costRow(int i) const { return cost_matrix.data() + static_cast<size_t>(i - 1) * m; }
+    Cost cost(int i, int j) const { return costRow(i)[j - 1]; }
+    void noteChange(int i, int j);
+    void repair();
+    void augment(int row);
+    // Settles a free column lowered by shiftColumn; returns the rows scanned.
+    int pull(int column);
     std::vector<int> solve();
-};
\ No newline at end of file
+};
+
+using HungarianAlgorithm = BasicHungarianAlgorithm<int32_t>;
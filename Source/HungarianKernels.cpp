@@ -0,0 +1,377 @@
+#include "HungarianKernels.h"
+#include <limits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HUNGARIAN_X86_KERNELS 1
+#include <immintrin.h>
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+using namespace std;
+
+namespace {
+    template <class Cost>
+    Cost relaxScalar(const Cost* row, Cost ui, const Cost* v, Cost* minv, int* way,
+                     const SimdMask<Cost>* used, int j0, int count, int* best) {
+        Cost delta = numeric_limits<Cost>::max();
+        int at = -1;
+        for (int k = 0; k < count; ++k) {
+            if (used[k]) continue;
+            const Cost cur = row[k] - ui - v[k];
+            if (cur < minv[k]) {
+                minv[k] = cur;
+                way[k] = j0;
+            }
+            if (minv[k] < delta) {
+                delta = minv[k];
+                at = k;
+            }
+        }
+        *best = at;
+        return delta;
+    }
+
+    template <class Cost>
+    void shiftScalar(Cost* v, Cost* minv, const SimdMask<Cost>* used, Cost delta, int count) {
+        for (int k = 0; k < count; ++k) {
+            if (used[k]) v[k] -= delta;
+            else minv[k] -= delta;
+        }
+    }
+
+#ifdef HUNGARIAN_X86_KERNELS
+    // Folds per-lane minima (each with the first index it was seen at) and the
+    // scalar tail [from, count) into the overall first minimum.
+    template <class Cost, int Lanes>
+    Cost finishRelax(const Cost* laneBest, const SimdMask<Cost>* laneIndex,
+                     const Cost* row, Cost ui, const Cost* v, Cost* minv, int* way,
+                     const SimdMask<Cost>* used, int j0, int from, int count, int* best) {
+        Cost delta = numeric_limits<Cost>::max();
+        int at = -1;
+        for (int l = 0; l < Lanes; ++l) {
+            const int index = static_cast<int>(laneIndex[l]);
+            if (laneBest[l] < delta || (laneBest[l] == delta && at >= 0 && index < at)) {
+                delta = laneBest[l];
+                at = index;
+            }
+        }
+        int tailAt;
+        const Cost tail = relaxScalar(row + from, ui, v + from, minv + from, way + from,
+                                      used + from, j0, count - from, &tailAt);
+        if (tail < delta) {
+            delta = tail;
+            at = from + tailAt;
+        }
+        *best = at;
+        return delta;
+    }
+
+    // AVX2: masks are whole vectors of 0 / all-ones lanes, kept as __m256i.
+    struct Avx2Int32 {
+        using T = int32_t;
+        using V = __m256i;
+        static const int lanes = 8;
+        TARGET_AVX2 static V load(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        TARGET_AVX2 static void store(T* p, V x) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x); }
+        TARGET_AVX2 static V set1(T x) { return _mm256_set1_epi32(x); }
+        TARGET_AVX2 static V sub(V a, V b) { return _mm256_sub_epi32(a, b); }
+        TARGET_AVX2 static __m256i lt(V a, V b) { return _mm256_cmpgt_epi32(b, a); }
+        TARGET_AVX2 static V select(V a, V b, __m256i mask) { return _mm256_blendv_epi8(a, b, mask); }
+        TARGET_AVX2 static V keep(V x, __m256i mask) { return _mm256_and_si256(x, mask); }
+        TARGET_AVX2 static V drop(V x, __m256i mask) { return _mm256_andnot_si256(mask, x); }
+        TARGET_AVX2 static __m256i iota() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+        TARGET_AVX2 static __m256i advance(__m256i index) { return _mm256_add_epi32(index, _mm256_set1_epi32(lanes)); }
+        TARGET_AVX2 static void storeWay(int* way, __m256i mask, int j0) {
+            _mm256_maskstore_epi32(way, mask, _mm256_set1_epi32(j0));
+        }
+    };
+
+    struct Avx2Float {
+        using T = float;
+        using V = __m256;
+        static const int lanes = 8;
+        TARGET_AVX2 static V load(const T* p) { return _mm256_loadu_ps(p); }
+        TARGET_AVX2 static void store(T* p, V x) { _mm256_storeu_ps(p, x); }
+        TARGET_AVX2 static V set1(T x) { return _mm256_set1_ps(x); }
+        TARGET_AVX2 static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+        TARGET_AVX2 static __m256i lt(V a, V b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+        TARGET_AVX2 static V select(V a, V b, __m256i mask) { return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(mask)); }
+        TARGET_AVX2 static V keep(V x, __m256i mask) { return _mm256_and_ps(x, _mm256_castsi256_ps(mask)); }
+        TARGET_AVX2 static V drop(V x, __m256i mask) { return _mm256_andnot_ps(_mm256_castsi256_ps(mask), x); }
+        TARGET_AVX2 static __m256i iota() { return Avx2Int32::iota(); }
+        TARGET_AVX2 static __m256i advance(__m256i index) { return Avx2Int32::advance(index); }
+        TARGET_AVX2 static void storeWay(int* way, __m256i mask, int j0) { Avx2Int32::storeWay(way, mask, j0); }
+    };
+
+    struct Avx2Int64 {
+        using T = int64_t;
+        using V = __m256i;
+        static const int lanes = 4;
+        TARGET_AVX2 static V load(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        TARGET_AVX2 static void store(T* p, V x) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x); }
+        TARGET_AVX2 static V set1(T x) { return _mm256_set1_epi64x(x); }
+        TARGET_AVX2 static V sub(V a, V b) { return _mm256_sub_epi64(a, b); }
+        TARGET_AVX2 static __m256i lt(V a, V b) { return _mm256_cmpgt_epi64(b, a); }
+        TARGET_AVX2 static V select(V a, V b, __m256i mask) { return _mm256_blendv_epi8(a, b, mask); }
+        TARGET_AVX2 static V keep(V x, __m256i mask) { return _mm256_and_si256(x, mask); }
+        TARGET_AVX2 static V drop(V x, __m256i mask) { return _mm256_andnot_si256(mask, x); }
+        TARGET_AVX2 static __m256i iota() { return _mm256_setr_epi64x(0, 1, 2, 3); }
+        TARGET_AVX2 static __m256i advance(__m256i index) { return _mm256_add_epi64(index, _mm256_set1_epi64x(lanes)); }
+        TARGET_AVX2 static void storeWay(int* way, __m256i mask, int j0) {
+            // The low halves of the four 64-bit mask lanes drive a 4 x 32-bit store.
+            const __m256i packed = _mm256_permutevar8x32_epi32(mask, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+            _mm_maskstore_epi32(way, _mm256_castsi256_si128(packed), _mm_set1_epi32(j0));
+        }
+    };
+
+    struct Avx2Double {
+        using T = double;
+        using V = __m256d;
+        static const int lanes = 4;
+        TARGET_AVX2 static V load(const T* p) { return _mm256_loadu_pd(p); }
+        TARGET_AVX2 static void store(T* p, V x) { _mm256_storeu_pd(p, x); }
+        TARGET_AVX2 static V set1(T x) { return _mm256_set1_pd(x); }
+        TARGET_AVX2 static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+        TARGET_AVX2 static __m256i lt(V a, V b) { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+        TARGET_AVX2 static V select(V a, V b, __m256i mask) { return _mm256_blendv_pd(a, b, _mm256_castsi256_pd(mask)); }
+        TARGET_AVX2 static V keep(V x, __m256i mask) { return _mm256_and_pd(x, _mm256_castsi256_pd(mask)); }
+        TARGET_AVX2 static V drop(V x, __m256i mask) { return _mm256_andnot_pd(_mm256_castsi256_pd(mask), x); }
+        TARGET_AVX2 static __m256i iota() { return Avx2Int64::iota(); }
+        TARGET_AVX2 static __m256i advance(__m256i index) { return Avx2Int64::advance(index); }
+        TARGET_AVX2 static void storeWay(int* way, __m256i mask, int j0) { Avx2Int64::storeWay(way, mask, j0); }
+    };
+
+    template <class Tr>
+    TARGET_AVX2 typename Tr::T relaxAvx2(const typename Tr::T* row, typename Tr::T ui, const typename Tr::T* v,
+                                         typename Tr::T* minv, int* way, const SimdMask<typename Tr::T>* used,
+                                         int j0, int count, int* best) {
+        using T = typename Tr::T;
+        using V = typename Tr::V;
+        const V vui = Tr::set1(ui);
+        V laneMin = Tr::set1(numeric_limits<T>::max());
+        __m256i laneAt = _mm256_setzero_si256();
+        __m256i index = Tr::iota();
+
+        int k = 0;
+        for (; k + Tr::lanes <= count; k += Tr::lanes) {
+            const __m256i inTree = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(used + k));
+            V mv = Tr::load(minv + k);
+            const V cur = Tr::sub(Tr::sub(Tr::load(row + k), vui), Tr::load(v + k));
+            const __m256i better = _mm256_andnot_si256(inTree, Tr::lt(cur, mv));
+            mv = Tr::select(mv, cur, better);
+            Tr::store(minv + k, mv);
+            Tr::storeWay(way + k, better, j0);
+
+            const __m256i lower = _mm256_andnot_si256(inTree, Tr::lt(mv, laneMin));
+            laneMin = Tr::select(laneMin, mv, lower);
+            laneAt = _mm256_blendv_epi8(laneAt, index, lower);
+            index = Tr::advance(index);
+        }
+
+        alignas(32) T laneBest[Tr::lanes];
+        alignas(32) SimdMask<T> laneIndex[Tr::lanes];
+        Tr::store(laneBest, laneMin);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneIndex), laneAt);
+        return finishRelax<T, Tr::lanes>(laneBest, laneIndex, row, ui, v, minv, way, used, j0, k, count, best);
+    }
+
+    template <class Tr>
+    TARGET_AVX2 void shiftAvx2(typename Tr::T* v, typename Tr::T* minv, const SimdMask<typename Tr::T>* used,
+                               typename Tr::T delta, int count) {
+        using V = typename Tr::V;
+        const V vdelta = Tr::set1(delta);
+        int k = 0;
+        for (; k + Tr::lanes <= count; k += Tr::lanes) {
+            const __m256i inTree = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(used + k));
+            Tr::store(v + k, Tr::sub(Tr::load(v + k), Tr::keep(vdelta, inTree)));
+            Tr::store(minv + k, Tr::sub(Tr::load(minv + k), Tr::drop(vdelta, inTree)));
+        }
+        shiftScalar(v + k, minv + k, used + k, delta, count - k);
+    }
+
+    // AVX-512: masks live in k registers; "free" is a column not yet in the tree.
+    struct Avx512Int32 {
+        using T = int32_t;
+        using V = __m512i;
+        using K = __mmask16;
+        static const int lanes = 16;
+        TARGET_AVX512 static V load(const T* p) { return _mm512_loadu_si512(p); }
+        TARGET_AVX512 static void store(T* p, V x) { _mm512_storeu_si512(p, x); }
+        TARGET_AVX512 static V set1(T x) { return _mm512_set1_epi32(x); }
+        TARGET_AVX512 static V sub(V a, V b) { return _mm512_sub_epi32(a, b); }
+        TARGET_AVX512 static V subMasked(V src, K k, V b) { return _mm512_mask_sub_epi32(src, k, src, b); }
+        TARGET_AVX512 static K lt(K k, V a, V b) { return _mm512_mask_cmplt_epi32_mask(k, a, b); }
+        TARGET_AVX512 static V move(V src, K k, V a) { return _mm512_mask_mov_epi32(src, k, a); }
+        TARGET_AVX512 static K freeMask(const int32_t* used) {
+            return _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(used), _mm512_setzero_si512());
+        }
+        TARGET_AVX512 static __m512i iota() {
+            return _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        }
+        TARGET_AVX512 static __m512i advance(__m512i index) { return _mm512_add_epi32(index, _mm512_set1_epi32(lanes)); }
+        TARGET_AVX512 static __m512i moveIndex(__m512i src, K k, __m512i a) { return _mm512_mask_mov_epi32(src, k, a); }
+        TARGET_AVX512 static void storeWay(int* way, K k, int j0) { _mm512_mask_storeu_epi32(way, k, _mm512_set1_epi32(j0)); }
+    };
+
+    struct Avx512Float {
+        using T = float;
+        using V = __m512;
+        using K = __mmask16;
+        static const int lanes = 16;
+        TARGET_AVX512 static V load(const T* p) { return _mm512_loadu_ps(p); }
+        TARGET_AVX512 static void store(T* p, V x) { _mm512_storeu_ps(p, x); }
+        TARGET_AVX512 static V set1(T x) { return _mm512_set1_ps(x); }
+        TARGET_AVX512 static V sub(V a, V b) { return _mm512_sub_ps(a, b); }
+        TARGET_AVX512 static V subMasked(V src, K k, V b) { return _mm512_mask_sub_ps(src, k, src, b); }
+        TARGET_AVX512 static K lt(K k, V a, V b) { return _mm512_mask_cmp_ps_mask(k, a, b, _CMP_LT_OQ); }
+        TARGET_AVX512 static V move(V src, K k, V a) { return _mm512_mask_mov_ps(src, k, a); }
+        TARGET_AVX512 static K freeMask(const int32_t* used) { return Avx512Int32::freeMask(used); }
+        TARGET_AVX512 static __m512i iota() { return Avx512Int32::iota(); }
+        TARGET_AVX512 static __m512i advance(__m512i index) { return Avx512Int32::advance(index); }
+        TARGET_AVX512 static __m512i moveIndex(__m512i src, K k, __m512i a) { return Avx512Int32::moveIndex(src, k, a); }
+        TARGET_AVX512 static void storeWay(int* way, K k, int j0) { Avx512Int32::storeWay(way, k, j0); }
+    };
+
+    struct Avx512Int64 {
+        using T = int64_t;
+        using V = __m512i;
+        using K = __mmask8;
+        static const int lanes = 8;
+        TARGET_AVX512 static V load(const T* p) { return _mm512_loadu_si512(p); }
+        TARGET_AVX512 static void store(T* p, V x) { _mm512_storeu_si512(p, x); }
+        TARGET_AVX512 static V set1(T x) { return _mm512_set1_epi64(x); }
+        TARGET_AVX512 static V sub(V a, V b) { return _mm512_sub_epi64(a, b); }
+        TARGET_AVX512 static V subMasked(V src, K k, V b) { return _mm512_mask_sub_epi64(src, k, src, b); }
+        TARGET_AVX512 static K lt(K k, V a, V b) { return _mm512_mask_cmplt_epi64_mask(k, a, b); }
+        TARGET_AVX512 static V move(V src, K k, V a) { return _mm512_mask_mov_epi64(src, k, a); }
+        TARGET_AVX512 static K freeMask(const int64_t* used) {
+            return _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(used), _mm512_setzero_si512());
+        }
+        TARGET_AVX512 static __m512i iota() { return _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7); }
+        TARGET_AVX512 static __m512i advance(__m512i index) { return _mm512_add_epi64(index, _mm512_set1_epi64(lanes)); }
+        TARGET_AVX512 static __m512i moveIndex(__m512i src, K k, __m512i a) { return _mm512_mask_mov_epi64(src, k, a); }
+        TARGET_AVX512 static void storeWay(int* way, K k, int j0) {
+            _mm512_mask_cvtepi64_storeu_epi32(way, k, _mm512_set1_epi64(j0));
+        }
+    };
+
+    struct Avx512Double {
+        using T = double;
+        using V = __m512d;
+        using K = __mmask8;
+        static const int lanes = 8;
+        TARGET_AVX512 static V load(const T* p) { return _mm512_loadu_pd(p); }
+        TARGET_AVX512 static void store(T* p, V x) { _mm512_storeu_pd(p, x); }
+        TARGET_AVX512 static V set1(T x) { return _mm512_set1_pd(x); }
+        TARGET_AVX512 static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+        TARGET_AVX512 static V subMasked(V src, K k, V b) { return _mm512_mask_sub_pd(src, k, src, b); }
+        TARGET_AVX512 static K lt(K k, V a, V b) { return _mm512_mask_cmp_pd_mask(k, a, b, _CMP_LT_OQ); }
+        TARGET_AVX512 static V move(V src, K k, V a) { return _mm512_mask_mov_pd(src, k, a); }
+        TARGET_AVX512 static K freeMask(const int64_t* used) { return Avx512Int64::freeMask(used); }
+        TARGET_AVX512 static __m512i iota() { return Avx512Int64::iota(); }
+        TARGET_AVX512 static __m512i advance(__m512i index) { return Avx512Int64::advance(index); }
+        TARGET_AVX512 static __m512i moveIndex(__m512i src, K k, __m512i a) { return Avx512Int64::moveIndex(src, k, a); }
+        TARGET_AVX512 static void storeWay(int* way, K k, int j0) { Avx512Int64::storeWay(way, k, j0); }
+    };
+
+    template <class Tr>
+    TARGET_AVX512 typename Tr::T relaxAvx512(const typename Tr::T* row, typename Tr::T ui, const typename Tr::T* v,
+                                             typename Tr::T* minv, int* way, const SimdMask<typename Tr::T>* used,
+                                             int j0, int count, int* best) {
+        using T = typename Tr::T;
+        using V = typename Tr::V;
+        using K = typename Tr::K;
+        const V vui = Tr::set1(ui);
+        V laneMin = Tr::set1(numeric_limits<T>::max());
+        __m512i laneAt = _mm512_setzero_si512();
+        __m512i index = Tr::iota();
+
+        int k = 0;
+        for (; k + Tr::lanes <= count; k += Tr::lanes) {
+            const K free = Tr::freeMask(used + k);
+            V mv = Tr::load(minv + k);
+            const V cur = Tr::sub(Tr::sub(Tr::load(row + k), vui), Tr::load(v + k));
+            const K better = Tr::lt(free, cur, mv);
+            mv = Tr::move(mv, better, cur);
+            Tr::store(minv + k, mv);
+            Tr::storeWay(way + k, better, j0);
+
+            const K lower = Tr::lt(free, mv, laneMin);
+            laneMin = Tr::move(laneMin, lower, mv);
+            laneAt = Tr::moveIndex(laneAt, lower, index);
+            index = Tr::advance(index);
+        }
+
+        alignas(64) T laneBest[Tr::lanes];
+        alignas(64) SimdMask<T> laneIndex[Tr::lanes];
+        Tr::store(laneBest, laneMin);
+        _mm512_storeu_si512(laneIndex, laneAt);
+        return finishRelax<T, Tr::lanes>(laneBest, laneIndex, row, ui, v, minv, way, used, j0, k, count, best);
+    }
+
+    template <class Tr>
+    TARGET_AVX512 void shiftAvx512(typename Tr::T* v, typename Tr::T* minv, const SimdMask<typename Tr::T>* used,
+                                   typename Tr::T delta, int count) {
+        using V = typename Tr::V;
+        using K = typename Tr::K;
+        const V vdelta = Tr::set1(delta);
+        int k = 0;
+        for (; k + Tr::lanes <= count; k += Tr::lanes) {
+            const K free = Tr::freeMask(used + k);
+            Tr::store(v + k, Tr::subMasked(Tr::load(v + k), static_cast<K>(~free), vdelta));
+            Tr::store(minv + k, Tr::subMasked(Tr::load(minv + k), free, vdelta));
+        }
+        shiftScalar(v + k, minv + k, used + k, delta, count - k);
+    }
+
+    template <class Cost> struct X86Kernels;
+    template <> struct X86Kernels<int32_t> { using Avx2 = Avx2Int32; using Avx512 = Avx512Int32; };
+    template <> struct X86Kernels<int64_t> { using Avx2 = Avx2Int64; using Avx512 = Avx512Int64; };
+    template <> struct X86Kernels<float> { using Avx2 = Avx2Float; using Avx512 = Avx512Float; };
+    template <> struct X86Kernels<double> { using Avx2 = Avx2Double; using Avx512 = Avx512Double; };
+#endif
+}
+
+SimdLevel detectSimdLevel() {
+#ifdef HUNGARIAN_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::Avx2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+SimdLevel activeSimdLevel() {
+    static const SimdLevel detected = detectSimdLevel();
+    return detected;
+}
+
+template <class Cost>
+RelaxKernel<Cost> relaxKernel(SimdLevel level) {
+#ifdef HUNGARIAN_X86_KERNELS
+    if (level == SimdLevel::Avx512) return &relaxAvx512<typename X86Kernels<Cost>::Avx512>;
+    if (level == SimdLevel::Avx2) return &relaxAvx2<typename X86Kernels<Cost>::Avx2>;
+#endif
+    (void)level;
+    return &relaxScalar<Cost>;
+}
+
+template <class Cost>
+ShiftKernel<Cost> shiftKernel(SimdLevel level) {
+#ifdef HUNGARIAN_X86_KERNELS
+    if (level == SimdLevel::Avx512) return &shiftAvx512<typename X86Kernels<Cost>::Avx512>;
+    if (level == SimdLevel::Avx2) return &shiftAvx2<typename X86Kernels<Cost>::Avx2>;
+#endif
+    (void)level;
+    return &shiftScalar<Cost>;
+}
+
+template RelaxKernel<int32_t> relaxKernel<int32_t>(SimdLevel);
+template RelaxKernel<int64_t> relaxKernel<int64_t>(SimdLevel);
+template RelaxKernel<float> relaxKernel<float>(SimdLevel);
+template RelaxKernel<double> relaxKernel<double>(SimdLevel);
+template ShiftKernel<int32_t> shiftKernel<int32_t>(SimdLevel);
+template ShiftKernel<int64_t> shiftKernel<int64_t>(SimdLevel);
+template ShiftKernel<float> shiftKernel<float>(SimdLevel);
+template ShiftKernel<double> shiftKernel<double>(SimdLevel);
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+// Inner loops of the Hungarian augmenting-path search, in a scalar version and,
+// on x86 with GCC or Clang, AVX2 and AVX-512 versions chosen at run time. All
+// versions produce bit-identical results: the arg-min always goes to the lowest
+// column index, exactly like the scalar loop.
+
+enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+// Widest level the CPU (and this build) supports.
+SimdLevel detectSimdLevel();
+// Level used by newly constructed solvers: the detected one, looked up once.
+SimdLevel activeSimdLevel();
+
+// Per-column "already in the search tree" flag: 0 or all ones, one lane as wide
+// as the cost type so it can be loaded directly as a vector mask.
+template <class Cost>
+using SimdMask = typename std::conditional<sizeof(Cost) == 4, int32_t, int64_t>::type;
+
+// Relaxation from row i0 over columns k in [0, count):
+//   for every k with !used[k]: if row[k] - ui - v[k] < minv[k], lower minv[k] to it and set way[k] = j0.
+// Returns the smallest minv[k] over free columns and stores its first index in *best.
+template <class Cost>
+using RelaxKernel = Cost (*)(const Cost* row, Cost ui, const Cost* v, Cost* minv, int* way,
+                             const SimdMask<Cost>* used, int j0, int count, int* best);
+
+// Potential shift by delta: v[k] -= delta on used columns, minv[k] -= delta on free ones.
+template <class Cost>
+using ShiftKernel = void (*)(Cost* v, Cost* minv, const SimdMask<Cost>* used, Cost delta, int count);
+
+template <class Cost>
+RelaxKernel<Cost> relaxKernel(SimdLevel level);
+template <class Cost>
+ShiftKernel<Cost> shiftKernel(SimdLevel level);
@@ -0,0 +1,223 @@
+#include "LocalSearch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include "ThreadPool.h"
+#include "Stats.h"
+
+using namespace std;
+
+LocalSearch::LocalSearch(const Graph& G, const OverlayGraph& H)
+    : G(G), H(H), out(G.size), in(G.size) {
+    for (int i = 0; i < G.size; ++i) {
+        G.forEachOutNeighbor(i, [&](int j) {
+            out[i].push_back(j);
+            in[j].push_back(i);
+        });
+    }
+}
+
+int LocalSearch::incidentMissing(const vector<int>& mapping, int u, int a, int v, int b) const {
+    auto image = [&](int w) { return w == u ? a : (w == v ? b : mapping[w]); };
+    int count = 0;
+    // Each edge is counted once: u's out-edges (self-loop included), u's other
+    // in-edges, then v's edges that do not lead to or from u.
+    for (int w : out[u]) count += missing(a, image(w));
+    for (int w : in[u]) {
+        if (w != u) count += missing(image(w), a);
+    }
+    if (v >= 0) {
+        for (int w : out[v]) {
+            if (w != u) count += missing(b, image(w));
+        }
+        for (int w : in[v]) {
+            if (w != u && w != v) count += missing(image(w), b);
+        }
+    }
+    return count;
+}
+
+int LocalSearch::swapGain(const vector<int>& mapping, int u, int v) const {
+    const int a = mapping[u];
+    const int b = mapping[v];
+    return incidentMissing(mapping, u, a, v, b) - incidentMissing(mapping, u, b, v, a);
+}
+
+int LocalSearch::replaceGain(const vector<int>& mapping, int u, int target) const {
+    return incidentMissing(mapping, u, mapping[u], -1, -1) - incidentMissing(mapping, u, target, -1, -1);
+}
+
+LocalSearch::Move LocalSearch::bestMove(const vector<int>& mapping, const vector<int>& owner, int u) const {
+    Move best;
+    const int before = incidentMissing(mapping, u, mapping[u], -1, -1);
+    // With all of u's edges present, only a swap can help, and the partner's
+    // own search finds it.
+    if (before == 0) return best;
+
+    for (int v = 0; v < G.size; ++v) {
+        if (v == u) continue;
+        const int gain = swapGain(mapping, u, v);
+        if (gain > best.gain) best = Move{ gain, u, v, -1 };
+    }
+
+    // Stamps mark the targets already scored for this vertex.
+    thread_local vector<int> seen;
+    thread_local int stamp = 0;
+    if (seen.size() != static_cast<size_t>(H.size)) seen.assign(H.size, 0);
+    ++stamp;
+
+    auto consider = [&](int x) {
+        if (owner[x] != -1 || seen[x] == stamp) return;
+        seen[x] = stamp;
+        const int gain = before - incidentMissing(mapping, u, x, -1, -1);
+        // Targets arrive in storage order, which differs between the dense and
+        // sparse forms; equal gains go to the lowest target.
+        if (gain > best.gain || (gain == best.gain && best.target >= 0 && x < best.target)) {
+            best = Move{ gain, u, -1, x };
+        }
+    };
+    for (int w : out[u]) {
+        if (w != u) H.forEachInNeighbor(mapping[w], consider);
+    }
+    for (int w : in[u]) {
+        if (w != u) H.forEachOutNeighbor(mapping[w], consider);
+    }
+    return best;
+}
+
+int LocalSearch::refine(vector<int>& mapping, int maxRounds) {
+    STATS_TIMER(LocalSearchRefine);
+    const int n = G.size;
+    vector<int> owner(H.size, -1);
+    for (int i = 0; i < n; ++i) owner[mapping[i]] = i;
+
+    int saved = 0;
+    const long long movesBefore = movesApplied;
+    vector<Move> best(n);
+    vector<Move> improving;
+
+    for (int round = 0; round < maxRounds; ++round) {
+        ThreadPool::shared().parallelFor(0, n, [&](int u) {
+            best[u] = bestMove(mapping, owner, u);
+        });
+
+        improving.clear();
+        for (const Move& mv : best) {
+            if (mv.gain > 0) improving.push_back(mv);
+        }
+        if (improving.empty()) break;
+        ++roundCount;
+
+        // Best first; stable, so equal gains stay in vertex order.
+        stable_sort(improving.begin(), improving.end(),
+                    [](const Move& x, const Move& y) { return x.gain > y.gain; });
+
+        for (const Move& mv : improving) {
+            // Earlier moves of this round may have changed the neighbourhood.
+            int gain;
+            if (mv.v >= 0) {
+                gain = swapGain(mapping, mv.u, mv.v);
+                if (gain <= 0) continue;
+                swap(mapping[mv.u], mapping[mv.v]);
+                owner[mapping[mv.u]] = mv.u;
+                owner[mapping[mv.v]] = mv.v;
+            } else {
+                if (owner[mv.target] != -1) continue;
+                gain = replaceGain(mapping, mv.u, mv.target);
+                if (gain <= 0) continue;
+                owner[mapping[mv.u]] = -1;
+                mapping[mv.u] = mv.target;
+                owner[mv.target] = mv.u;
+            }
+            saved += gain;
+            ++movesApplied;
+        }
+    }
+
+    STATS_ADD(LocalSearchMoves, movesApplied - movesBefore);
+    return saved;
+}
+
+int LocalSearch::anneal(vector<int>& mapping, const AnnealSchedule& schedule) {
+    STATS_TIMER(Annealing);
+    const int n = G.size;
+    const int m = H.size;
+    if (n == 0 || schedule.iterations <= 0 || (n == 1 && n == m)) return 0;
+
+    vector<int> owner(m, -1);
+    for (int i = 0; i < n; ++i) owner[mapping[i]] = i;
+    // Unused H vertices, for drawing replacement targets in O(1).
+    vector<int> freeList;
+    vector<int> freePos(m, -1);
+    for (int x = 0; x < m; ++x) {
+        if (owner[x] == -1) {
+            freePos[x] = static_cast<int>(freeList.size());
+            freeList.push_back(x);
+        }
+    }
+
+    int current = 0;
+    for (int u = 0; u < n; ++u) {
+        for (int w : out[u]) current += missing(mapping[u], mapping[w]);
+    }
+    const int initial = current;
+    int best = current;
+    vector<int> bestMapping = mapping;
+
+    // Raw draws rather than std distributions, whose output differs between
+    // standard libraries.
+    mt19937 rng(schedule.seed);
+    const auto start = chrono::steady_clock::now();
+    const double cooling = log(schedule.endTemperature / schedule.startTemperature);
+    double temperature = schedule.startTemperature;
+    long long accepted = 0;
+
+    for (long long it = 0; it < schedule.iterations && best > 0; ++it) {
+        if (it % ANNEAL_CHECK_INTERVAL == 0) {
+            double progress = static_cast<double>(it) / schedule.iterations;
+            if (schedule.seconds > 0) {
+                const double used = chrono::duration<double>(chrono::steady_clock::now() - start).count() / schedule.seconds;
+                if (used >= 1.0) break;
+                progress = max(progress, used);
+            }
+            temperature = schedule.startTemperature * exp(cooling * progress);
+        }
+
+        const int u = static_cast<int>(rng() % n);
+        const bool replace = !freeList.empty() && (n == 1 || (rng() & 1));
+        int v = -1;
+        int target = -1;
+        int gain;
+        if (replace) {
+            target = freeList[rng() % freeList.size()];
+            gain = replaceGain(mapping, u, target);
+        } else {
+            v = static_cast<int>(rng() % (n - 1));
+            if (v >= u) ++v;
+            gain = swapGain(mapping, u, v);
+        }
+        if (gain < 0 && rng() * (1.0 / 4294967296.0) >= exp(gain / temperature)) continue;
+
+        if (replace) {
+            const int old = mapping[u];
+            freeList[freePos[target]] = old;
+            freePos[old] = freePos[target];
+            freePos[target] = -1;
+            mapping[u] = target;
+        } else {
+            swap(mapping[u], mapping[v]);
+        }
+        current -= gain;
+        ++accepted;
+        if (current < best) {
+            best = current;
+            bestMapping = mapping;
+        }
+    }
+
+    mapping = std::move(bestMapping);
+    movesApplied += accepted;
+    STATS_ADD(AnnealMoves, accepted);
+    return initial - best;
+}
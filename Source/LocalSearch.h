@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include "Graph.h"
+#include "OverlayGraph.h"
+
+// Local search on an injective mapping G -> H that lowers the number of edges
+// H lacks (evaluateMapping). Two moves:
+//   swap     two G vertices exchange their H images;
+//   replace  one G vertex moves to an H vertex no G vertex uses.
+// A move only changes the edges touching the moved vertices, so its gain is
+// computed in O(deg) from G's adjacency lists and H.hasEdge.
+//
+// Every round finds the best move of each G vertex in parallel on the shared
+// ThreadPool, then applies the improving ones best first, re-scoring each
+// against the mapping as it is by then and skipping those that no longer
+// help. Each applied move lowers the cost, so refine() always terminates; the
+// round limit bounds its time. Ties go to the lower vertex, so the result does
+// not depend on the number of threads.
+//
+// Replacement targets are restricted to H vertices adjacent to the image of a
+// neighbour of the moved vertex: any other target covers none of its edges.
+//
+// anneal() escapes the local optima refine() stops in: simulated annealing
+// over random moves of both kinds, scored the same way.
+class LocalSearch {
+public:
+    static const int DEFAULT_ROUNDS = 100;
+    // anneal() reads the clock and updates the temperature this often.
+    static const int ANNEAL_CHECK_INTERVAL = 256;
+
+    struct AnnealSchedule {
+        long long iterations = 0;       // moves tried
+        double seconds = 0.0;           // also stop after this long (0 = no limit)
+        unsigned seed = 1;
+        // The temperature falls geometrically from start to end over the
+        // budget (whichever of iterations and seconds runs out first).
+        double startTemperature = 2.0;
+        double endTemperature = 0.05;
+    };
+
+    // Both graphs must outlive the search; H is the host as extended so far.
+    LocalSearch(const Graph& G, const OverlayGraph& H);
+
+    // Improves mapping in place; returns by how much its cost went down.
+    int refine(std::vector<int>& mapping, int maxRounds = DEFAULT_ROUNDS);
+    // A move that raises the cost by d is taken with probability
+    // exp(-d / temperature), all others always. Leaves the best mapping seen
+    // in place and returns by how much its cost went down. Single-threaded;
+    // without a time limit the same seed gives the same result everywhere.
+    int anneal(std::vector<int>& mapping, const AnnealSchedule& schedule);
+
+    long long moves() const { return movesApplied; }
+    int rounds() const { return roundCount; }
+
+private:
+    struct Move {
+        int gain = 0;     // cost decrease, > 0 for improving moves
+        int u = -1;
+        int v = -1;       // swap partner, -1 for a replacement
+        int target = -1;  // replacement H vertex
+    };
+
+    const Graph& G;
+    const OverlayGraph& H;
+    std::vector<std::vector<int>> out;   // G out-neighbours
+    std::vector<std::vector<int>> in;    // G in-neighbours
+    long long movesApplied = 0;
+    int roundCount = 0;
+
+    int missing(int a, int b) const { return H.hasEdge(a, b) ? 0 : 1; }
+    // Missing edges among those touching u or v when u sits on a and v on b
+    // (v = -1: only u); every other vertex keeps its image.
+    int incidentMissing(const std::vector<int>& mapping, int u, int a, int v, int b) const;
+    int swapGain(const std::vector<int>& mapping, int u, int v) const;
+    int replaceGain(const std::vector<int>& mapping, int u, int target) const;
+    Move bestMove(const std::vector<int>& mapping, const std::vector<int>& owner, int u) const;
+};
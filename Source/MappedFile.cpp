@@ -0,0 +1,91 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+shared_ptr<MappedFile> MappedFile::open(const string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return nullptr;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    shared_ptr<MappedFile> mapped(new MappedFile());
+    mapped->base = static_cast<char*>(view);
+    mapped->length = static_cast<size_t>(fileSize.QuadPart);
+    mapped->fileHandle = file;
+    mapped->mappingHandle = mapping;
+    return mapped;
+}
+
+void MappedFile::adviseSequential() {
+    // FILE_FLAG_SEQUENTIAL_SCAN on the handle already asks for read-ahead.
+}
+
+MappedFile::~MappedFile() {
+    if (base) UnmapViewOfFile(base);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+}
+
+#else
+
+shared_ptr<MappedFile> MappedFile::open(const string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const size_t length = static_cast<size_t>(info.st_size);
+    void* view = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    if (view == MAP_FAILED) return nullptr;
+
+    shared_ptr<MappedFile> mapped(new MappedFile());
+    mapped->base = static_cast<char*>(view);
+    mapped->length = length;
+    return mapped;
+}
+
+void MappedFile::adviseSequential() {
+#ifdef MADV_SEQUENTIAL
+    madvise(base, length, MADV_SEQUENTIAL);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    if (base) munmap(base, length);
+}
+
+#endif
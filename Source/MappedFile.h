@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// A whole file mapped into memory copy-on-write (MAP_PRIVATE / FILE_MAP_COPY):
+// pages are read from the file on first touch, and writes go to private copies
+// that never reach the file. The mapping lives as long as the last shared_ptr.
+class MappedFile {
+public:
+    // nullptr when the file cannot be opened or mapped (empty files included).
+    static std::shared_ptr<MappedFile> open(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    char* data() { return base; }
+    const char* data() const { return base; }
+    std::size_t size() const { return length; }
+
+    // Hints that the mapping will be read front to back once (read-ahead).
+    void adviseSequential();
+
+private:
+    MappedFile() = default;
+
+    char* base = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
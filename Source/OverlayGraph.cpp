@@ -0,0 +1,31 @@
+#include "OverlayGraph.h"
+
+using namespace std;
+
+OverlayGraph::OverlayGraph(const Graph& base)
+    : size(base.size), H(&base), outAdded(base.size), inAdded(base.size),
+      baseOut(base.size, 0), baseIn(base.size, 0) {
+    // In-degrees from one pass over the out-neighbours: a dense column scan
+    // per vertex would be O(m^2).
+    for (int u = 0; u < size; ++u) {
+        baseOut[u] = base.outDegree(u);
+        base.forEachOutNeighbor(u, [&](int w) { baseIn[w]++; });
+        baseEdges += baseOut[u];
+    }
+}
+
+bool OverlayGraph::addEdge(int u, int v) {
+    if (H->hasEdge(u, v) || !added.insert(key(u, v)).second) return false;
+    outAdded[u].push_back(v);
+    inAdded[v].push_back(u);
+    return true;
+}
+
+Graph OverlayGraph::materialize() const {
+    if (!H) return Graph();
+    Graph g = *H;
+    for (int u = 0; u < size; ++u) {
+        for (int w : outAdded[u]) g.addEdge(u, w);
+    }
+    return g;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+#include "Graph.h"
+
+// A host graph H with edges added on top, without copying H: a read-only base
+// plus a hash set of the added edges (and the same edges as per-vertex lists
+// for walking neighbours). It answers hasEdge, degrees and the
+// forEach...Neighbor walks like a Graph, so extending H costs O(added edges)
+// instead of a full O(m^2)-bit copy. Degrees of the base are counted once in
+// the constructor, so outDegree / inDegree are O(1) in both graph forms.
+//
+// The base must outlive the overlay (and its copies). materialize() builds
+// the extended graph as a Graph, for display.
+class OverlayGraph {
+public:
+    int size = 0;
+
+    OverlayGraph() = default;
+    explicit OverlayGraph(const Graph& base);
+
+    const Graph& base() const { return *H; }
+
+    bool hasEdge(int u, int v) const {
+        return H->hasEdge(u, v) || (!outAdded[u].empty() && added.count(key(u, v)) != 0);
+    }
+    // Adds u -> v unless the base or an earlier addition has it; true if added.
+    bool addEdge(int u, int v);
+    int outDegree(int u) const { return baseOut[u] + static_cast<int>(outAdded[u].size()); }
+    int inDegree(int v) const { return baseIn[v] + static_cast<int>(inAdded[v].size()); }
+    int addedCount() const { return static_cast<int>(added.size()); }
+    int edgeCount() const { return baseEdges + addedCount(); }
+
+    // The base's neighbours first, then the added ones in order of addition.
+    template <class Fn> void forEachOutNeighbor(int u, Fn&& fn) const;
+    template <class Fn> void forEachInNeighbor(int v, Fn&& fn) const;
+
+    Graph materialize() const;
+
+private:
+    const Graph* H = nullptr;
+    std::unordered_set<uint64_t> added;
+    std::vector<std::vector<int>> outAdded;
+    std::vector<std::vector<int>> inAdded;
+    std::vector<int> baseOut;
+    std::vector<int> baseIn;
+    int baseEdges = 0;
+
+    static uint64_t key(int u, int v) { return (static_cast<uint64_t>(u) << 32) | static_cast<uint32_t>(v); }
+};
+
+template <class Fn>
+inline void OverlayGraph::forEachOutNeighbor(int u, Fn&& fn) const {
+    H->forEachOutNeighbor(u, fn);
+    for (int w : outAdded[u]) fn(w);
+}
+
+template <class Fn>
+inline void OverlayGraph::forEachInNeighbor(int v, Fn&& fn) const {
+    H->forEachInNeighbor(v, fn);
+    for (int w : inAdded[v]) fn(w);
+}
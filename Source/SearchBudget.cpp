@@ -0,0 +1,31 @@
+#include "SearchBudget.h"
+#include <climits>
+
+using namespace std;
+
+SearchBudget::SearchBudget(double timeLimitSeconds, long long nodeLimit)
+    : start(chrono::steady_clock::now()), deadlineSet(timeLimitSeconds > 0), nodeLimit(nodeLimit),
+      visited(0), stop(false), reportedCost(INT_MAX) {
+    if (deadlineSet) {
+        deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(timeLimitSeconds));
+    }
+}
+
+bool SearchBudget::charge(long long count) {
+    const long long total = visited.fetch_add(count, memory_order_relaxed) + count;
+    if ((nodeLimit > 0 && total >= nodeLimit) || (deadlineSet && chrono::steady_clock::now() >= deadline)) {
+        stop.store(true, memory_order_relaxed);
+    }
+    return stopped();
+}
+
+void SearchBudget::improved(int cost) {
+    lock_guard<mutex> guard(reportLock);
+    if (cost >= reportedCost) return;
+    reportedCost = cost;
+    if (onIncumbent) onIncumbent(cost, elapsedSeconds());
+}
+
+double SearchBudget::elapsedSeconds() const {
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+
+// Cooperative limits for a (parallel) search: a node budget and a wall-clock
+// budget, both optional. Search threads count nodes locally and hand them over
+// with charge() every CHECK_INTERVAL nodes; once a limit is reached stopped()
+// turns true and every thread unwinds, keeping the best solution it has.
+//
+// improved() reports a new incumbent; onIncumbent is called for strictly
+// better costs only, one call at a time.
+class SearchBudget {
+public:
+    static const int CHECK_INTERVAL = 256;
+
+    // 0 = no limit.
+    SearchBudget(double timeLimitSeconds, long long nodeLimit);
+
+    bool limited() const { return deadlineSet || nodeLimit > 0; }
+    bool stopped() const { return stop.load(std::memory_order_relaxed); }
+
+    // Adds nodes to the shared count and checks both limits; returns stopped().
+    bool charge(long long count);
+    void improved(int cost);
+
+    long long nodes() const { return visited.load(std::memory_order_relaxed); }
+    double elapsedSeconds() const;
+
+    std::function<void(int cost, double seconds)> onIncumbent;
+
+private:
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point deadline;
+    bool deadlineSet;
+    long long nodeLimit;
+
+    std::atomic<long long> visited;
+    std::atomic<bool> stop;
+
+    std::mutex reportLock;
+    int reportedCost;
+};
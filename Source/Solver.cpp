@@ -0,0 +1,631 @@
+#include "Solver.h"
+#include "HungarianAlgorithm.h"
+#include "ThreadPool.h"
+#include "CostMatrixBuilder.h"
+#include "SparseAssignment.h"
+#include "AuctionAssignment.h"
+#include "SearchBudget.h"
+#include "LocalSearch.h"
+#include "Automorphisms.h"
+#include "ColumnSetRanking.h"
+#include "Stats.h"
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <memory>
+#include <numeric>
+
+using namespace std;
+
+// Dense n x m problems above this many cells switch to the sparse solver with
+// AUTO_CANDIDATES candidates per row, keeping memory at O(n * k + m).
+static const long long DENSE_CELL_LIMIT = 1LL << 26;
+static const int AUTO_CANDIDATES = 64;
+// Default annealing budget per copy, in moves per G vertex.
+static const long long ANNEAL_MOVES_PER_VERTEX = 1000;
+// Vertex sets step 3 of the copy loop tries per copy, ranked or re-solved.
+static const int MAX_SET_TRIES = 1000;
+
+static int candidatesPerRow(int n, int m, const SolverOptions& options) {
+    if (options.candidates > 0) return options.candidates;
+    return static_cast<long long>(n) * m > DENSE_CELL_LIMIT ? AUTO_CANDIDATES : 0;
+}
+
+// The vertex set of a mapping as an m-bit mask: the same for every order of
+// the same vertices, and hashable.
+static string vertexSetMask(const vector<int>& mapping, int m) {
+    string mask((m + 7) / 8, '\0');
+    for (int h : mapping) mask[h >> 3] |= static_cast<char>(1 << (h & 7));
+    return mask;
+}
+
+struct BestPerSet {
+    int dist;
+    vector<int> mapping;
+};
+
+struct Candidate {
+    int dist;
+    vector<int> mapping;
+};
+
+template <class Host>
+static int missingEdges(const Graph& G, const Host& H, const vector<int>& mapping) {
+    int edgesNeeded = 0;
+    for (int i = 0; i < G.size; ++i) {
+        const int hi = mapping[i];
+        G.forEachOutNeighbor(i, [&](int j) {
+            if (!H.hasEdge(hi, mapping[j])) {
+                edgesNeeded++;
+            }
+        });
+    }
+    return edgesNeeded;
+}
+
+int evaluateMapping(const Graph& G, const Graph& H, const vector<int>& mapping) {
+    return missingEdges(G, H, mapping);
+}
+
+int evaluateMapping(const Graph& G, const OverlayGraph& H, const vector<int>& mapping) {
+    return missingEdges(G, H, mapping);
+}
+
+
+// One cost variant of the copy loop, kept for the whole run: the builder
+// draws its variant ranks once and only re-reads H's degrees per copy, and on
+// the dense path the solver keeps the previous copy's costs, so a copy only
+// rewrites the columns of H vertices whose degrees changed.
+struct CostSlot {
+    CostMatrixBuilder costs;
+    unique_ptr<HungarianAlgorithm> solver;  // dense path only
+    vector<int> changedColumns;             // not yet applied to solver
+    bool filled = false;                    // solver holds a full cost matrix
+
+    CostSlot(const Graph& G, const OverlayGraph& H, unsigned variant, bool dense) : costs(G, H) {
+        costs.setVariant(variant);
+        if (dense) solver = make_unique<HungarianAlgorithm>(costs.rows(), costs.cols());
+    }
+};
+
+static pair<bool, vector<int>> hungarianMappingOne(
+    CostSlot& slot,
+    const OverlayGraph& H, // H as extended so far; slot.costs is brought up to date with it
+    const vector<bool>* forbidColsRow0 = nullptr, // if provided, columns marked true are forbidden for row 0
+    const SolverOptions& options = SolverOptions()
+) {
+    CostMatrixBuilder& costs = slot.costs;
+    int n = costs.rows();
+    int m = costs.cols();
+
+    if (n > m) {
+        return { false, {} };
+    }
+
+    // One row per G vertex, one column per H vertex; unused H vertices simply stay
+    // unassigned. If we want to force a different vertex-set than some previous one:
+    // forbid ALL vertices of that set for row 0, guaranteeing >= 1 vertex differs.
+    // Changed columns pile up until the dense solver applies them, so it
+    // misses none when a call in between is solved some other way.
+    costs.refreshHost(H, slot.changedColumns);
+    if (!slot.solver) slot.changedColumns.clear();
+    vector<int> assignment;
+    int k = candidatesPerRow(n, m, options);
+    if (options.auction) {
+        // Costs are produced row by row on demand, so nothing n x m is stored.
+        AuctionAssignment auction(n, m,
+            [&](int i, int* out) { costs.buildRow(i, out, i == 0 ? forbidColsRow0 : nullptr); },
+            [&](int i, int j) {
+                if (i == 0 && forbidColsRow0 && j < (int)forbidColsRow0->size() && (*forbidColsRow0)[j]) {
+                    return CostMatrixBuilder::FORBIDDEN;
+                }
+                return costs.cost(i, j);
+            },
+            options.epsilon);
+        assignment = auction.findMinCostAssignment();
+    }
+    else if (k > 0) {
+        // Sparse: only the k cheapest H vertices per G vertex. If they admit no
+        // assignment, widen the lists; at k == m every cell is allowed again.
+        while (true) {
+            k = min(k, m);
+            vector<int> rowStart, columns, cellCosts;
+            costs.buildCandidates(k, rowStart, columns, cellCosts, forbidColsRow0);
+            SparseAssignment sparse(n, m, std::move(rowStart), std::move(columns), std::move(cellCosts));
+            assignment = sparse.findMinCostAssignment();
+            if (!assignment.empty() || k == m) break;
+            k *= 2;
+        }
+        if (assignment.empty()) {
+            return { false, {} };
+        }
+    }
+    else if (slot.solver && !forbidColsRow0) {
+        // Only the changed columns are rewritten, row by row; the solver
+        // repairs just the cells whose cost actually differs.
+        HungarianAlgorithm& solver = *slot.solver;
+        if (!slot.filled) {
+            costs.build(solver.row(0), m);
+            slot.filled = true;
+        }
+        else {
+            for (int i = 0; i < n; ++i) {
+                for (int j : slot.changedColumns) solver.setCost(i, j, costs.cost(i, j));
+            }
+        }
+        slot.changedColumns.clear();
+        assignment = solver.findMinCostAssignment();
+    }
+    else {
+        HungarianAlgorithm hungarian(n, m); // rectangular assignment, no dummy rows
+        costs.build(hungarian.row(0), m, nullptr, forbidColsRow0);
+        assignment = hungarian.findMinCostAssignment();
+    }
+
+    vector<int> mapping(n);
+    for (int i = 0; i < n; ++i) {
+        mapping[i] = assignment[i];
+        if (mapping[i] < 0 || mapping[i] >= m) {
+            return { false, {} };
+        }
+    }
+
+    return { true, mapping };
+}
+
+
+
+ApproxResult hungarianApproximateExtendMany(const Graph& G, const Graph& H, int targetCopies,
+                                           const SolverOptions& options) {
+    ApproxResult result;
+    result.numCopies = 0;
+    result.totalExtEdges = 0;
+    // Each copy reads the host as extended so far and adds its edges after.
+    result.extendedH = OverlayGraph(H);
+    const OverlayGraph& currentH = result.extendedH;
+
+    auto start = chrono::high_resolution_clock::now();
+
+    const int n = G.size;
+    const int m = H.size;
+
+    if (n > m) {
+        auto end = chrono::high_resolution_clock::now();
+        result.hungarianTime = chrono::duration<double, milli>(end - start).count();
+        return result;
+    }
+
+    // Vertex sets used by accepted copies (order-independent), as masks.
+    unordered_set<string> usedSets;
+    // Slot 0 holds the plain costs, slots 1 .. K-1 the portfolio variants.
+    // Between copies H gains only a few edges, so every slot keeps its builder
+    // and dense solver for all copies and is warm started from the last one.
+    // The sparse and auction solvers have no dense matrix to keep, so they
+    // start afresh each time from the slot's builder.
+    const bool dense = !options.auction && candidatesPerRow(n, m, options) == 0;
+    const int variants = max(0, options.portfolio - 1);
+    vector<CostSlot> slots;
+    slots.reserve(variants + 1);
+    for (int v = 0; v <= variants; ++v) slots.emplace_back(G, currentH, static_cast<unsigned>(v), dense);
+
+    // The column-set ranking of step 3 depends only on H's degrees, so it
+    // carries over to the next copy as long as no copy adds an edge and every
+    // set it returned was used; it then never has to pass them again. It
+    // reads the plain costs of slot 0, which stay put while it is kept.
+    unique_ptr<ColumnSetRanking> ranking;
+
+    auto outOfTime = [&]() {
+        return options.timeLimit > 0
+            && chrono::duration<double>(chrono::high_resolution_clock::now() - start).count() >= options.timeLimit;
+    };
+
+    while (targetCopies == -1 || result.numCopies < targetCopies) {
+        if (outOfTime()) {
+            result.stoppedEarly = true;
+            break;
+        }
+
+        // 1) Get a Hungarian mapping
+        auto mappingResult = hungarianMappingOne(slots[0], currentH, nullptr, options);
+        if (!mappingResult.first) break;
+
+        vector<int> mapping = mappingResult.second;
+
+        // 2) The vertex set decides whether the copy is new.
+        string vertexSet = vertexSetMask(mapping, m);
+
+        // 3) If this vertex set was used before, take the cheapest assignment
+        //    on a set that was not. The dense path ranks the column sets of
+        //    the plain costs in order (ColumnSetRanking), which meets each
+        //    used set at most once. Sparse and auction solvers have no matrix
+        //    to rank, so they forbid the whole set for row 0 and re-solve,
+        //    which guarantees at least one vertex differs. Either way at most
+        //    MAX_SET_TRIES sets are tried.
+        string rankedSet;
+        const bool duplicate = usedSets.count(vertexSet) != 0;
+        if (duplicate) {
+            bool found = false;
+            if (dense) {
+                if (!ranking) ranking = make_unique<ColumnSetRanking>(slots[0].costs);
+                vector<int> ranked;
+                long long rankedCost = 0;
+                for (int tries = 0; tries < MAX_SET_TRIES && !outOfTime() && ranking->next(ranked, rankedCost); ++tries) {
+                    STATS_ADD(DuplicateSetRetries, 1);
+                    rankedSet = vertexSetMask(ranked, m);
+                    if (!usedSets.count(rankedSet)) {
+                        mapping = std::move(ranked);
+                        vertexSet = rankedSet;
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            else {
+                for (int retry = 0; retry < MAX_SET_TRIES && !found && !outOfTime(); ++retry) {
+                    STATS_ADD(DuplicateSetRetries, 1);
+                    vector<bool> forbidCols(m, false);
+                    for (int v : mapping) forbidCols[v] = true;
+
+                    auto altRes = hungarianMappingOne(slots[0], currentH, &forbidCols, options);
+                    if (!altRes.first) break;   // no mapping differs by >= 1 vertex
+                    mapping = altRes.second;
+                    vertexSet = vertexSetMask(mapping, m);
+                    found = !usedSets.count(vertexSet);
+                }
+            }
+            if (!found) {
+                result.stoppedEarly = outOfTime();
+                break;
+            }
+        }
+
+        // 3a) Portfolio: keep the variant mapping with the fewest missing edges
+        //     whose vertex set is new; the plain mapping wins ties.
+        if (variants > 0) {
+            vector<vector<int>> found(variants);
+            vector<int> missing(variants, INT_MAX);
+            ThreadPool::shared().parallelFor(0, variants, [&](int v) {
+                auto variantResult = hungarianMappingOne(slots[v + 1], currentH, nullptr, options);
+                if (!variantResult.first) return;
+                if (usedSets.count(vertexSetMask(variantResult.second, m))) return;
+                missing[v] = evaluateMapping(G, currentH, variantResult.second);
+                found[v] = std::move(variantResult.second);
+            });
+            int bestMissing = evaluateMapping(G, currentH, mapping);
+            int winner = -1;
+            for (int v = 0; v < variants; ++v) {
+                if (missing[v] < bestMissing) {
+                    bestMissing = missing[v];
+                    winner = v;
+                }
+            }
+            if (winner >= 0) {
+                STATS_ADD(PortfolioWins, 1);
+                mapping = std::move(found[winner]);
+                vertexSet = vertexSetMask(mapping, m);
+            }
+        }
+
+        // 3b) Optional refinement: the assignment costs only see degrees, not
+        //     which H edges lie between the chosen vertices. A refined mapping
+        //     is kept only if its vertex set is still a new one.
+        if (options.refine || options.anneal) {
+            vector<int> refined = mapping;
+            LocalSearch search(G, currentH);
+            int saved = search.refine(refined);
+            if (options.anneal) {
+                LocalSearch::AnnealSchedule schedule;
+                schedule.iterations = options.iterations > 0 ? options.iterations
+                                                             : ANNEAL_MOVES_PER_VERTEX * static_cast<long long>(n);
+                schedule.seed = options.seed + static_cast<unsigned>(result.numCopies);
+                if (options.timeLimit > 0) {
+                    // Share what is left of the limit among the copies still to place.
+                    const double left = options.timeLimit
+                        - chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+                    schedule.seconds = targetCopies > 0 ? left / (targetCopies - result.numCopies) : left;
+                    if (left <= 0) schedule.iterations = 0;
+                }
+                const int annealed = search.anneal(refined, schedule);
+                if (annealed > 0) saved += annealed + search.refine(refined);
+            }
+            if (saved > 0) {
+                string refinedSet = vertexSetMask(refined, m);
+                if (!usedSets.count(refinedSet)) {
+                    mapping = std::move(refined);
+                    vertexSet = std::move(refinedSet);
+                }
+            }
+        }
+
+        // 4) Accept mapping and extend H (edges may overlap; count only newly added edges)
+        int edgesAdded = 0;
+        for (int i = 0; i < n; ++i) {
+            const int hi = mapping[i];
+            G.forEachOutNeighbor(i, [&](int j) {
+                if (result.extendedH.addEdge(hi, mapping[j])) edgesAdded++;
+            });
+        }
+
+        result.totalExtEdges += edgesAdded;
+        result.numCopies++;
+        if (edgesAdded > 0 || (!rankedSet.empty() && rankedSet != vertexSet)) {
+            ranking.reset();
+        }
+
+        usedSets.insert(std::move(vertexSet));
+
+        // "As many as possible" ends once H stops growing: the cheapest mapping
+        // repeated a used set and the replacement needed no new edge, so the
+        // costs would stay the same and only lead to copies H already holds.
+        if (targetCopies == -1 && duplicate && edgesAdded == 0) break;
+    }
+
+    auto end = chrono::high_resolution_clock::now();
+    result.hungarianTime = chrono::duration<double, milli>(end - start).count();
+
+    return result;
+}
+
+SolveResult runHungarian(const Graph& G, const Graph& H, int targetCopies,
+                         const SolverOptions& options) {
+    SolveResult res{};
+    res.edgesG = G.edgeCount();
+    res.edgesH = H.edgeCount();
+
+    res.copiesRequested = targetCopies;
+
+    ApproxResult a = hungarianApproximateExtendMany(G, H, targetCopies, options);
+
+    res.copiesFound = a.numCopies;
+    res.totalEdgesAdded = a.totalExtEdges;
+    res.stoppedEarly = a.stoppedEarly;
+
+
+    res.duration_sec = a.hungarianTime / 1000.0;
+
+    res.H_ext = std::move(a.extendedH);
+    res.edgesHext = res.H_ext.edgeCount();
+
+    res.bestDistance = INT_MAX;
+    res.isSubgraph = false;
+
+    return res;
+}
+
+static int ExtendGraph(const Graph& G, OverlayGraph& H_ext, const std::vector<int>& mapping) {
+    const int n = G.size;
+    int added = 0;
+
+    for (int uG = 0; uG < n; ++uG) {
+        int uH = mapping[uG];
+        G.forEachOutNeighbor(uG, [&](int vG) {
+            if (H_ext.addEdge(uH, mapping[vG])) added++;
+        });
+    }
+    return added;
+}
+
+
+SolveResult ExactMinExtendGraph(const Graph& G, const Graph& H, int targetCopies, const SolverOptions& options) {
+    using namespace std;
+    using namespace std::chrono;
+
+    SolveResult res{};
+    res.edgesG = G.edgeCount();
+    res.edgesH = H.edgeCount();
+
+    auto start = high_resolution_clock::now();
+    SearchBudget budget(options.timeLimit, options.nodeLimit);
+    budget.onIncumbent = options.onIncumbent;
+    SearchBudget* limits = (budget.limited() || budget.onIncumbent) ? &budget : nullptr;
+
+    OverlayGraph H_ext(H);
+    if (targetCopies == 1) {
+        bool complete = true;
+        auto result = G.FindBestMapping(H, limits, &complete, options.assignmentBound);
+        res.stoppedEarly = !complete;
+        res.bestMapping = result.first;
+        res.bestDistance = result.second;
+
+        
+        if (res.bestDistance != 0 && res.bestDistance != INT_MAX) {
+            ExtendGraph(G, H_ext, res.bestMapping);
+        }
+
+        res.isSubgraph = (res.bestDistance == 0);
+        res.copiesFound = (res.bestDistance == INT_MAX ? 0 : 1);
+        res.H_ext = std::move(H_ext);
+        res.edgesHext = res.H_ext.edgeCount();
+        res.totalEdgesAdded = res.edgesHext - res.edgesH;
+
+    }
+    else {
+
+        const int n = G.size;
+        const int m = H.size;
+        // Edges between uG and the G vertices mapped before it (0..uG-1), so the
+        // distance of a mapping is accumulated one level at a time along the DFS.
+        vector<vector<int>> earlierOut(n), earlierIn(n);
+        for (int uG = 0; uG < n; ++uG) {
+            for (int vG = 0; vG < uG; ++vG) {
+                if (G.hasEdge(uG, vG)) earlierOut[uG].push_back(vG);
+                if (G.hasEdge(vG, uG)) earlierIn[uG].push_back(vG);
+            }
+        }
+
+        auto levelCost = [&](const vector<int>& mapping, int uG, int vH) -> int {
+            int cost = (G.hasEdge(uG, uG) && !H.hasEdge(vH, vH)) ? 1 : 0;
+            for (int vG : earlierOut[uG]) {
+                if (!H.hasEdge(vH, mapping[vG])) cost++;
+            }
+            for (int vG : earlierIn[uG]) {
+                if (!H.hasEdge(mapping[vG], vH)) cost++;
+            }
+            return cost;
+            };
+
+        // Mappings that differ by an automorphism of G add the same edges to the
+        // same vertex set, so only one mapping per class is enumerated: vertex
+        // uG's image must exceed those of symmetry.below(uG).
+        vector<int> identity(n);
+        iota(identity.begin(), identity.end(), 0);
+        const Automorphisms symmetry(G, identity);
+        STATS_ADD(SymmetryConstraints, symmetry.constraints());
+        auto imageFloor = [&](const vector<int>& images, int uG) -> int {
+            int floor = -1;
+            for (int vG : symmetry.below(uG)) floor = max(floor, images[vG]);
+            return floor;
+            };
+
+        // The enumeration is split by the images of the first one or two G vertices;
+        // each piece keeps its own best-per-set table and the tables are merged in
+        // sequential order, so the outcome is independent of the thread count.
+        STATS_TIMER(ExactEnumeration);
+        ThreadPool& pool = ThreadPool::shared();
+        const int prefixLen = min(n, (m < 4 * pool.size()) ? 2 : 1);
+        vector<vector<int>> prefixes;
+        {
+            vector<int> prefix;
+            function<void()> expand = [&]() {
+                if ((int)prefix.size() == prefixLen) {
+                    prefixes.push_back(prefix);
+                    return;
+                }
+                for (int vH = imageFloor(prefix, (int)prefix.size()) + 1; vH < m; ++vH) {
+                    if (find(prefix.begin(), prefix.end(), vH) != prefix.end()) continue;
+                    prefix.push_back(vH);
+                    expand();
+                    prefix.pop_back();
+                }
+                };
+            expand();
+        }
+
+        vector<unordered_map<string, BestPerSet>> pieces(prefixes.size());
+        ThreadPool::TaskGroup group;
+        for (size_t t = 0; t < prefixes.size(); ++t) {
+            pool.submit(group, [&, t] {
+                unordered_map<string, BestPerSet>& bestForSet = pieces[t];
+                vector<int> mapping(n, -1);
+                vector<char> usedH(m, false);
+                // usedH as a byte mask, kept up to date along the path so a
+                // leaf looks up its set without building a key.
+                string setMask((m + 7) / 8, '\0');
+                auto toggle = [&](int vH) { setMask[vH >> 3] ^= static_cast<char>(1 << (vH & 7)); };
+                int prefixCost = 0;
+                for (int k = 0; k < prefixLen; ++k) {
+                    mapping[k] = prefixes[t][k];
+                    usedH[mapping[k]] = true;
+                    toggle(mapping[k]);
+                    prefixCost += levelCost(mapping, k, mapping[k]);
+                }
+
+                long long visited = 0;
+                function<void(int, int)> dfs = [&](int uG, int dist) {
+                    ++visited;
+                    if (limits) {
+                        if (limits->stopped()) return;
+                        if (visited % SearchBudget::CHECK_INTERVAL == 0 && limits->charge(SearchBudget::CHECK_INTERVAL)) return;
+                    }
+                    if (uG == n) {
+                        auto it = bestForSet.find(setMask);
+                        if (it == bestForSet.end()) {
+                            bestForSet.emplace(setMask, BestPerSet{ dist, mapping });
+                        }
+                        else if (dist < it->second.dist) {
+                            it->second.dist = dist;
+                            it->second.mapping = mapping;
+                        }
+                        return;
+                    }
+
+                    for (int vH = imageFloor(mapping, uG) + 1; vH < m; ++vH) {
+                        if (usedH[vH]) continue;
+                        usedH[vH] = true;
+                        toggle(vH);
+                        mapping[uG] = vH;
+                        dfs(uG + 1, dist + levelCost(mapping, uG, vH));
+                        mapping[uG] = -1;
+                        toggle(vH);
+                        usedH[vH] = false;
+                        if (limits && limits->stopped()) break;
+                    }
+                    };
+
+                dfs(prefixLen, prefixCost);
+                // The nodes since the last whole interval, which a small task never reaches.
+                if (limits) limits->charge(visited % SearchBudget::CHECK_INTERVAL);
+                STATS_ADD(ExactNodes, visited);
+                });
+        }
+        pool.wait(group);
+        // Stopped early: only the vertex sets met so far compete for the copies.
+        res.stoppedEarly = limits && limits->stopped();
+
+        unordered_map<string, BestPerSet> bestForSet;
+        bestForSet.reserve(1024);
+        for (auto& piece : pieces) {
+            for (auto& kv : piece) {
+                auto it = bestForSet.find(kv.first);
+                if (it == bestForSet.end() || kv.second.dist < it->second.dist) {
+                    bestForSet[kv.first] = std::move(kv.second);
+                }
+            }
+            piece.clear();
+        }
+
+        vector<Candidate> cand;
+        cand.reserve(bestForSet.size());
+        for (auto& kv : bestForSet) {
+            cand.push_back(Candidate{ kv.second.dist, kv.second.mapping });
+        }
+
+        // Equal distances are ordered by mapping so the chosen copies never depend
+        // on hash-table iteration order.
+        sort(cand.begin(), cand.end(), [](const Candidate& a, const Candidate& b) {
+            if (a.dist != b.dist) return a.dist < b.dist;
+            return a.mapping < b.mapping;
+            });
+
+        int copiesFound = min(targetCopies, (int)cand.size());
+
+        int edgesAddedTotal = 0;
+
+        for (int idx = 0; idx < copiesFound; ++idx) {
+            const auto& mapGtoH = cand[idx].mapping;
+
+            edgesAddedTotal += ExtendGraph(G, H_ext, mapGtoH);
+        }
+
+        res.H_ext = std::move(H_ext);
+        res.edgesHext = res.H_ext.edgeCount();
+        res.totalEdgesAdded = edgesAddedTotal;
+        res.copiesFound = copiesFound;
+        res.isSubgraph = false;
+        res.bestDistance = INT_MAX;
+    }
+
+    auto end = high_resolution_clock::now();
+    res.duration_sec = duration_cast<duration<double>>(end - start).count();
+    return res;
+}
+
+bool isKnownAlgorithm(const string& algorithm) {
+    return algorithm == "exact" || algorithm == "hungarian" || algorithm == "auction" || algorithm == "anneal";
+}
+
+SolveResult solve(const string& algorithm, const Graph& G, const Graph& H, int targetCopies,
+                  SolverOptions options) {
+    if (algorithm == "exact") {
+        return ExactMinExtendGraph(G, H, targetCopies <= 0 ? 1 : targetCopies, options);
+    }
+    // auction: same copy loop and costs as hungarian, different assignment solver.
+    // anneal: the hungarian mappings, each improved by simulated annealing.
+    options.auction = (algorithm == "auction");
+    if (algorithm == "anneal") options.anneal = true;
+    return runHungarian(G, H, targetCopies, options);
+}
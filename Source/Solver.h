@@ -0,0 +1,98 @@
+#pragma once
+
+#include <climits>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Graph.h"
+#include "OverlayGraph.h"
+
+// The minimum-extension solvers behind MainResolver, callable without any
+// console output (the resolver, its batch mode and the benchmark use them).
+
+// Settings from the command line that change how the solvers work.
+struct SolverOptions {
+    // Candidate H vertices kept per G vertex for the sparse assignment solver;
+    // 0 = dense Hungarian, unless the dense matrix would be too large (DENSE_CELL_LIMIT).
+    int candidates = 0;
+    // Solve the assignments with the parallel auction algorithm instead.
+    bool auction = false;
+    // Auction: final epsilon; the result is within n * epsilon of optimal (0 = exact).
+    double epsilon = 0.0;
+    // Approximations: improve every copy's mapping by local search (swap and
+    // replace moves, see LocalSearch) before H is extended with it.
+    bool refine = false;
+    // Approximations: solve this many cost variants per copy in parallel
+    // (perturbed tie-breaking, see CostMatrixBuilder::setVariant) and keep
+    // the mapping with the fewest missing edges; 0 or 1 = the plain costs only.
+    int portfolio = 0;
+    // Approximations: also run simulated annealing on every copy (the anneal
+    // algorithm), trying `iterations` moves per copy (0 = 1000 per G vertex).
+    // timeLimit then bounds the whole run; seed makes runs repeatable.
+    bool anneal = false;
+    long long iterations = 0;
+    unsigned seed = 1;
+    // Exact: stop the search after this many seconds / search nodes (0 = no
+    // limit) and return the best result found so far, marked stoppedEarly.
+    // Anneal: timeLimit bounds the annealing of all copies together.
+    double timeLimit = 0.0;
+    long long nodeLimit = 0;
+    // Exact, one copy: also bound every node by an assignment problem over
+    // the unmapped vertices (fewer nodes, more work per node; see ExactSearch).
+    bool assignmentBound = true;
+    // Exact, one copy: called with each strictly better mapping cost found.
+    std::function<void(int cost, double seconds)> onIncumbent;
+};
+
+// The extended hosts below are overlays on the H passed in (see OverlayGraph)
+// and are only valid while that H is; materialize() gives a standalone Graph.
+struct ApproxResult {
+    int numCopies;
+    int totalExtEdges;
+    OverlayGraph extendedH;
+    double hungarianTime;
+    // --time-limit ended the copy loop before the requested copies were placed.
+    bool stoppedEarly = false;
+};
+
+struct SolveResult {
+    OverlayGraph H_ext;
+    double duration_sec = 0.0;
+
+    int edgesG = 0;
+    int edgesH = 0;
+    int edgesHext = 0;
+
+    int copiesRequested = 1;
+    int copiesFound = 0;
+    int totalEdgesAdded = 0;
+
+    int bestDistance = INT_MAX;
+    std::vector<int> bestMapping;
+    bool isSubgraph = false;
+    // A time or node limit ended the search: the result is not proven optimal.
+    bool stoppedEarly = false;
+};
+
+// Number of edges H lacks to contain G under mapping (G vertex -> H vertex).
+int evaluateMapping(const Graph& G, const Graph& H, const std::vector<int>& mapping);
+int evaluateMapping(const Graph& G, const OverlayGraph& H, const std::vector<int>& mapping);
+
+// Hungarian approximation: repeatedly maps G onto the (growing) extension of H,
+// each copy on a vertex set not used before, until targetCopies copies are
+// placed (-1 = as many as possible).
+ApproxResult hungarianApproximateExtendMany(const Graph& G, const Graph& H, int targetCopies = -1,
+                                           const SolverOptions& options = SolverOptions());
+SolveResult runHungarian(const Graph& G, const Graph& H, int targetCopies = -1,
+                         const SolverOptions& options = SolverOptions());
+
+// Exact minimum extension for targetCopies distinct copies of G in H.
+SolveResult ExactMinExtendGraph(const Graph& G, const Graph& H, int targetCopies,
+                                const SolverOptions& options = SolverOptions());
+
+// "exact", "hungarian", "auction" or "anneal" (lower case).
+bool isKnownAlgorithm(const std::string& algorithm);
+// Runs one algorithm on a loaded pair; algorithm must be known. exact treats
+// targetCopies <= 0 as one copy.
+SolveResult solve(const std::string& algorithm, const Graph& G, const Graph& H, int targetCopies,
+                  SolverOptions options = SolverOptions());
@@ -0,0 +1,115 @@
+#include "SparseAssignment.h"
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <utility>
+#include "Stats.h"
+
+using namespace std;
+
+SparseAssignment::SparseAssignment(int rows, int cols,
+                                   vector<int> rowStart, vector<int> columns, vector<int> costs)
+    : n(rows), m(cols), rowStart(std::move(rowStart)), columns(std::move(columns)), costs(std::move(costs)) {
+}
+
+vector<int> SparseAssignment::findMinCostAssignment() {
+    if (n > m) return {};
+    STATS_TIMER(SparseSolve);
+    long long steps = 0;
+
+    // Dual potentials: cost - u[i] - v[j] >= 0 on every allowed cell and == 0 on
+    // matched ones. v only ever decreases, and only on scanned matched columns,
+    // so free columns keep v == 0 as a partial assignment requires.
+    vector<long long> u(n, 0), v(m, 0);
+    vector<int> rowOf(m, -1), colOf(n, -1);
+
+    // Per-search scratch; only the touched columns are reset between rows.
+    vector<long long> dist(m, LLONG_MAX);
+    vector<int> pred(m, -1);
+    vector<char> done(m, false);
+    vector<int> touched, scannedRows, scannedCols;
+    typedef pair<long long, int> Entry;
+    vector<Entry> heap;
+
+    for (int root = 0; root < n; ++root) {
+        long long reach = 0;   // length of the shortest path found so far
+        int sink = -1;
+        int i = root;
+        while (true) {
+            scannedRows.push_back(i);
+            for (int e = rowStart[i]; e < rowStart[i + 1]; ++e) {
+                const int j = columns[e];
+                if (done[j]) continue;
+                const long long d = reach + costs[e] - u[i] - v[j];
+                if (d < dist[j]) {
+                    if (dist[j] == LLONG_MAX) touched.push_back(j);
+                    dist[j] = d;
+                    pred[j] = i;
+                    heap.emplace_back(d, j);
+                    push_heap(heap.begin(), heap.end(), greater<Entry>());
+                }
+            }
+
+            // Closest unscanned column; stale heap entries are skipped.
+            int next = -1;
+            while (!heap.empty()) {
+                pop_heap(heap.begin(), heap.end(), greater<Entry>());
+                const Entry top = heap.back();
+                heap.pop_back();
+                if (!done[top.second] && top.first == dist[top.second]) {
+                    next = top.second;
+                    break;
+                }
+            }
+            if (next < 0) break;
+
+            reach = dist[next];
+            done[next] = true;
+            scannedCols.push_back(next);
+            if (rowOf[next] < 0) {
+                sink = next;
+                break;
+            }
+            i = rowOf[next];
+        }
+
+        if (sink < 0) {
+            // Hall's condition fails among the allowed cells of the rows reached.
+            return {};
+        }
+
+        // Shift the potentials so the new path is tight and every cell stays non-negative.
+        u[root] += reach;
+        for (int r : scannedRows) {
+            if (r != root) u[r] += reach - dist[colOf[r]];
+        }
+        for (int j : scannedCols) {
+            v[j] -= reach - dist[j];
+        }
+
+        // Flip the matching along the path.
+        for (int j = sink; ; ) {
+            const int r = pred[j];
+            const int previous = colOf[r];
+            rowOf[j] = r;
+            colOf[r] = j;
+            if (r == root) break;
+            j = previous;
+        }
+
+        for (int j : touched) {
+            dist[j] = LLONG_MAX;
+            pred[j] = -1;
+            done[j] = false;
+        }
+        steps += static_cast<long long>(scannedCols.size());
+        touched.clear();
+        scannedRows.clear();
+        scannedCols.clear();
+        heap.clear();
+    }
+
+    STATS_ADD(AugmentingPaths, n);
+    STATS_ADD(AugmentingPathSteps, steps);
+    return colOf;
+}
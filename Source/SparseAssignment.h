@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+// Rectangular assignment (rows <= cols) over a sparse set of allowed cells,
+// stored in compressed-row form: row i may take the columns
+// columns[rowStart[i] .. rowStart[i+1]) at the matching costs. Memory is
+// O(rows + cols + allowed cells), so hosts far too large for a dense
+// rows x cols matrix still fit.
+//
+// Rows are matched one at a time along shortest augmenting paths (Dijkstra over
+// reduced costs with a binary heap, potentials kept as in Jonker-Volgenant), so
+// a solve takes O(rows * cells * log cells) in the worst case and much less when
+// the candidate lists are short. Costs must be non-negative. Ties between equal
+// path lengths go to the lower column index, so the result is deterministic.
+class SparseAssignment {
+public:
+    SparseAssignment(int rows, int cols,
+                     std::vector<int> rowStart, std::vector<int> columns, std::vector<int> costs);
+
+    int rows() const { return n; }
+    int cols() const { return m; }
+    long long cells() const { return static_cast<long long>(columns.size()); }
+
+    // result[i] = column assigned to row i; empty when the allowed cells admit
+    // no assignment of every row.
+    std::vector<int> findMinCostAssignment();
+
+private:
+    int n;
+    int m;
+    std::vector<int> rowStart;   // n + 1 offsets into columns / costs
+    std::vector<int> columns;
+    std::vector<int> costs;
+};
@@ -0,0 +1,77 @@
+#include "Stats.h"
+
+#ifdef SOLVER_STATS
+
+#include <iomanip>
+
+using namespace std;
+
+namespace stats {
+
+namespace {
+    const char* PHASE_NAMES[PHASE_COUNT] = {
+        "graph_loading", "degree_computation", "cost_matrix_build", "hungarian_solve",
+        "sparse_solve", "auction_solve", "exact_search", "exact_enumeration", "exact_assignment_bound",
+        "subgraph_prepass", "local_search", "annealing", "symmetry_detection"
+    };
+    const char* COUNTER_NAMES[COUNTER_COUNT] = {
+        "augmenting_paths", "augmenting_path_steps", "auction_bids", "duplicate_set_retries",
+        "ranked_subproblems", "portfolio_wins", "exact_nodes", "exact_pruned", "exact_bound_solves",
+        "exact_bound_pruned", "prepass_nodes", "symmetry_constraints", "local_search_moves", "anneal_moves"
+    };
+
+    atomic<long long> phaseNanos[PHASE_COUNT];
+    atomic<long long> phaseCalls[PHASE_COUNT];
+    atomic<long long> counters[COUNTER_COUNT];
+}
+
+void addTime(Phase phase, chrono::steady_clock::duration elapsed) {
+    phaseNanos[phase].fetch_add(chrono::duration_cast<chrono::nanoseconds>(elapsed).count(), memory_order_relaxed);
+    phaseCalls[phase].fetch_add(1, memory_order_relaxed);
+}
+
+void add(Counter counter, long long count) {
+    counters[counter].fetch_add(count, memory_order_relaxed);
+}
+
+void reset() {
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        phaseNanos[p] = 0;
+        phaseCalls[p] = 0;
+    }
+    for (int c = 0; c < COUNTER_COUNT; ++c) counters[c] = 0;
+}
+
+void report(ostream& out, bool json) {
+    const ios::fmtflags flags = out.flags();
+    const streamsize precision = out.precision();
+    out << fixed << setprecision(6);
+    if (json) {
+        out << "{\"phases\":{";
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            out << (p ? "," : "") << "\"" << PHASE_NAMES[p] << "\":{\"seconds\":" << phaseNanos[p] * 1e-9
+                << ",\"calls\":" << phaseCalls[p] << "}";
+        }
+        out << "},\"counters\":{";
+        for (int c = 0; c < COUNTER_COUNT; ++c) {
+            out << (c ? "," : "") << "\"" << COUNTER_NAMES[c] << "\":" << counters[c];
+        }
+        out << "}}" << endl;
+    }
+    else {
+        out << "=== SOLVER STATISTICS (times summed over threads) ===" << endl;
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            out << "  " << left << setw(24) << PHASE_NAMES[p] << right << setw(14) << phaseNanos[p] * 1e-9
+                << " s  " << setw(10) << phaseCalls[p] << " calls" << endl;
+        }
+        for (int c = 0; c < COUNTER_COUNT; ++c) {
+            out << "  " << left << setw(24) << COUNTER_NAMES[c] << right << setw(14) << counters[c] << endl;
+        }
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+}
+
+#endif
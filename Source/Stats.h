@@ -0,0 +1,86 @@
+#pragma once
+
+// Opt-in solver statistics: wall time and call count per phase plus event
+// counters, summed over all threads. Everything is compiled only when
+// SOLVER_STATS is defined (-DSOLVER_STATS); otherwise the macros below expand
+// to nothing and no code or data is left behind.
+//
+//   STATS_TIMER(Phase)        times the enclosing scope as one call of Phase
+//   STATS_ADD(Counter, count) adds to a counter (keep it out of inner loops:
+//                             count locally and add once)
+
+#ifdef SOLVER_STATS
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+
+namespace stats {
+
+enum Phase {
+    GraphLoading,
+    DegreeComputation,
+    CostMatrixBuild,
+    HungarianSolve,
+    SparseSolve,
+    AuctionSolve,
+    ExactBranchAndBound,
+    ExactEnumeration,
+    ExactAssignmentBound,
+    SubgraphPrepass,
+    LocalSearchRefine,
+    Annealing,
+    SymmetryDetection,
+    PHASE_COUNT
+};
+
+enum Counter {
+    AugmentingPaths,        // rows augmented by the Hungarian / sparse solvers
+    AugmentingPathSteps,    // columns added to the shortest-path trees
+    AuctionBids,
+    DuplicateSetRetries,    // assignments skipped because their vertex set was used already
+    RankedSubproblems,      // subproblems solved by the column-set ranking
+    PortfolioWins,          // copies where a cost variant beat the plain mapping
+    ExactNodes,
+    ExactPruned,
+    ExactBoundSolves,       // assignment lower bounds solved by the exact search
+    ExactBoundPruned,       // nodes those bounds pruned
+    PrepassNodes,           // nodes of the zero-cost embedding search
+    SymmetryConstraints,    // image-order constraints from G's automorphisms
+    LocalSearchMoves,       // swap / replace moves applied by the refinement
+    AnnealMoves,            // moves accepted by simulated annealing
+    COUNTER_COUNT
+};
+
+void addTime(Phase phase, std::chrono::steady_clock::duration elapsed);
+void add(Counter counter, long long count);
+void reset();
+// One line per phase and counter, or a single JSON object.
+void report(std::ostream& out, bool json);
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Phase phase) : phase(phase), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { addTime(phase, std::chrono::steady_clock::now() - start); }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Phase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+}
+
+#define STATS_CONCAT_(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT_(a, b)
+#define STATS_TIMER(phase) ::stats::ScopedTimer STATS_CONCAT(statsTimer_, __LINE__)(::stats::phase)
+#define STATS_ADD(counter, count) ::stats::add(::stats::counter, (count))
+
+#else
+
+#define STATS_TIMER(phase) ((void)0)
+// sizeof keeps locally accumulated counts "used" without evaluating them.
+#define STATS_ADD(counter, count) ((void)sizeof(count))
+
+#endif
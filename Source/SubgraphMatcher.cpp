@@ -0,0 +1,136 @@
+#include "SubgraphMatcher.h"
+#include "Stats.h"
+
+using namespace std;
+
+SubgraphMatcher::SubgraphMatcher(const Graph& G, const Graph& H)
+    : G(G), H(H), n(G.size), m(H.size), words(H.adj.usedWords()), hIn(H.size, H.size),
+      out(G.size), in(G.size), domains(G.size, Domain(words, 0)), mapping(G.size, -1) {
+    for (int x = 0; x < m; ++x) {
+        const uint64_t* row = H.adj.row(x);
+        for (int w = 0; w < words; ++w) {
+            for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                hIn.set(w * 64 + countTrailingZeros64(bits), x);
+            }
+        }
+    }
+    for (int u = 0; u < n; ++u) {
+        G.forEachOutNeighbor(u, [&](int v) {
+            if (v == u) return;
+            out[u].push_back(v);
+            in[v].push_back(u);
+        });
+    }
+}
+
+bool SubgraphMatcher::anyCommon(const uint64_t* row, const Domain& domain) const {
+    for (int w = 0; w < words; ++w) {
+        if (row[w] & domain[w]) return true;
+    }
+    return false;
+}
+
+bool SubgraphMatcher::refine() {
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int u = 0; u < n; ++u) {
+            Domain& domain = domains[u];
+            bool empty = true;
+            for (int w = 0; w < words; ++w) {
+                for (uint64_t bits = domain[w]; bits; bits &= bits - 1) {
+                    const int x = w * 64 + countTrailingZeros64(bits);
+                    bool keep = true;
+                    for (int v : out[u]) {
+                        if (!anyCommon(H.adj.row(x), domains[v])) { keep = false; break; }
+                    }
+                    for (int v : in[u]) {
+                        if (!keep) break;
+                        if (!anyCommon(hIn.row(x), domains[v])) keep = false;
+                    }
+                    if (!keep) {
+                        domain[w] &= ~(uint64_t(1) << (x & 63));
+                        changed = true;
+                    }
+                }
+                if (domain[w]) empty = false;
+            }
+            if (empty) return false;
+        }
+    }
+    return true;
+}
+
+SubgraphMatcher::Outcome SubgraphMatcher::run(long long nodeLimit) {
+    STATS_TIMER(SubgraphPrepass);
+    if (n > m) return NoEmbedding;
+
+    for (int u = 0; u < n; ++u) {
+        const bool loop = G.hasEdge(u, u);
+        const int outDegree = static_cast<int>(out[u].size());
+        const int inDegree = static_cast<int>(in[u].size());
+        for (int x = 0; x < m; ++x) {
+            const bool hLoop = H.hasEdge(x, x);
+            if (loop && !hLoop) continue;
+            if (H.adj.rowCount(x) - hLoop < outDegree || hIn.rowCount(x) - hLoop < inDegree) continue;
+            domains[u][x >> 6] |= uint64_t(1) << (x & 63);
+        }
+    }
+    if (!refine()) return NoEmbedding;
+
+    visited = 0;
+    limit = nodeLimit;
+    vector<Domain> current = domains;
+    const int found = search(current, 0);
+    STATS_ADD(PrepassNodes, visited);
+    if (found == 1) return Found;
+    return found == 0 ? NoEmbedding : Unknown;
+}
+
+int SubgraphMatcher::search(vector<Domain>& current, int depth) {
+    if (depth == n) return 1;
+    if (++visited > limit) return -1;
+
+    // Fail first: the unmapped vertex with the fewest candidates.
+    int u = -1;
+    int best = 0;
+    for (int v = 0; v < n; ++v) {
+        if (mapping[v] != -1) continue;
+        int count = 0;
+        for (int w = 0; w < words; ++w) count += popcount64(current[v][w]);
+        if (u < 0 || count < best) {
+            u = v;
+            best = count;
+        }
+    }
+
+    const Domain candidates = current[u];
+    for (int w = 0; w < words; ++w) {
+        for (uint64_t bits = candidates[w]; bits; bits &= bits - 1) {
+            const int x = w * 64 + countTrailingZeros64(bits);
+            vector<Domain> next = current;
+            bool possible = true;
+            for (int v = 0; v < n && possible; ++v) {
+                if (v == u || mapping[v] != -1) continue;
+                Domain& domain = next[v];
+                domain[x >> 6] &= ~(uint64_t(1) << (x & 63));
+                const uint64_t* toX = G.hasEdge(v, u) ? hIn.row(x) : nullptr;
+                const uint64_t* fromX = G.hasEdge(u, v) ? H.adj.row(x) : nullptr;
+                uint64_t any = 0;
+                for (int k = 0; k < words; ++k) {
+                    if (toX) domain[k] &= toX[k];
+                    if (fromX) domain[k] &= fromX[k];
+                    any |= domain[k];
+                }
+                possible = any != 0;
+            }
+            if (!possible) continue;
+
+            mapping[u] = x;
+            const int found = search(next, depth + 1);
+            if (found == 1) return 1;
+            mapping[u] = -1;
+            if (found < 0) return -1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "BitMatrix.h"
+#include "Graph.h"
+
+// Zero-cost pre-pass of the exact search: looks for an embedding of G in H,
+// an injective mapping under which every edge of G (self-loops included) is an
+// edge of H. H may have more edges.
+//
+// Every G vertex u gets a domain, a bitset of the H vertices that may host it.
+// It starts with those of at least u's out- and in-degree (and a self-loop if
+// u has one) and is refined Ullmann style until stable: x stays in u's domain
+// only if every out-neighbour w of u can go to an out-neighbour of x in w's
+// domain, and likewise for in-neighbours. The search then maps the vertex with
+// the smallest domain first and, after u -> x, intersects the domains of u's
+// neighbours with x's out- or in-neighbour rows (forward checking).
+//
+// Both graphs must be dense. The search is exponential in the worst case, so
+// it has a node limit; at the limit the outcome is Unknown.
+class SubgraphMatcher {
+public:
+    enum Outcome { Found, NoEmbedding, Unknown };
+    static const long long DEFAULT_NODE_LIMIT = 100000;
+
+    SubgraphMatcher(const Graph& G, const Graph& H);
+
+    Outcome run(long long nodeLimit = DEFAULT_NODE_LIMIT);
+
+    // The embedding found (run() returned Found).
+    const std::vector<int>& embedding() const { return mapping; }
+    // Whether x is in u's refined domain; empty domains mean NoEmbedding.
+    bool inDomain(int u, int x) const { return (domains[u][x >> 6] >> (x & 63)) & 1u; }
+    long long nodes() const { return visited; }
+
+private:
+    using Domain = std::vector<uint64_t>;
+
+    const Graph& G;
+    const Graph& H;
+    int n;
+    int m;
+    int words;
+    BitMatrix hIn;                            // transpose of H: row x = in-neighbours of x
+    std::vector<std::vector<int>> out;        // G without self-loops
+    std::vector<std::vector<int>> in;
+    std::vector<Domain> domains;
+    std::vector<int> mapping;
+    long long visited = 0;
+    long long limit = 0;
+
+    bool anyCommon(const uint64_t* row, const Domain& domain) const;
+    bool refine();
+    // 1 = found, 0 = none below, -1 = node limit.
+    int search(std::vector<Domain>& current, int depth);
+};
@@ -0,0 +1,164 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+namespace {
+    thread_local const ThreadPool* tlsPool = nullptr;
+    thread_local int tlsIndex = -1;
+
+    int requestedThreads = 0;
+}
+
+ThreadPool::ThreadPool(int threads) : queued(0), nextQueue(0), stopping(false) {
+    const int extra = max(0, threads - 1);
+    for (int i = 0; i <= extra; ++i) {
+        queues.push_back(make_unique<Queue>());
+    }
+    for (int i = 0; i < extra; ++i) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+int ThreadPool::currentIndex() const {
+    return tlsPool == this ? tlsIndex : -1;
+}
+
+void ThreadPool::submit(TaskGroup& group, function<void()> task) {
+    group.pending.fetch_add(1, memory_order_relaxed);
+
+    int self = currentIndex();
+    // Outside threads spread their work over the worker deques round-robin;
+    // the last queue is used only when the pool has no workers at all.
+    int target = self >= 0 ? self
+        : (workers.empty() ? static_cast<int>(queues.size()) - 1
+                           : static_cast<int>(nextQueue.fetch_add(1, memory_order_relaxed) % workers.size()));
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(Task{ std::move(task), &group });
+    }
+    queued.fetch_add(1, memory_order_release);
+    if (!workers.empty()) {
+        lock_guard<mutex> guard(sleepLock);
+        wake.notify_one();
+    }
+}
+
+bool ThreadPool::popTask(int self, Task& out) {
+    if (queued.load(memory_order_acquire) == 0) return false;
+
+    // Own work newest first (keeps caches warm), stolen work oldest first
+    // (the biggest remaining pieces of a split search tree).
+    if (self >= 0) {
+        Queue& own = *queues[self];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            out = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+    }
+
+    const int count = static_cast<int>(queues.size());
+    const int start = self >= 0 ? self + 1 : 0;
+    for (int k = 0; k < count; ++k) {
+        int victim = (start + k) % count;
+        if (victim == self) continue;
+        Queue& q = *queues[victim];
+        lock_guard<mutex> guard(q.lock);
+        if (!q.tasks.empty()) {
+            out = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            queued.fetch_sub(1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(Task& task) {
+    task.fn();
+    TaskGroup* group = task.group;
+    task.fn = nullptr;
+    if (group->pending.fetch_sub(1, memory_order_acq_rel) == 1) {
+        lock_guard<mutex> guard(sleepLock);
+        wake.notify_all();
+    }
+}
+
+bool ThreadPool::tryRun(int self) {
+    Task task;
+    if (!popTask(self, task)) return false;
+    execute(task);
+    return true;
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    const int self = currentIndex();
+    while (group.pending.load(memory_order_acquire) > 0) {
+        if (tryRun(self)) continue;
+
+        // Nothing to help with: the remaining tasks are running elsewhere.
+        unique_lock<mutex> guard(sleepLock);
+        wake.wait_for(guard, chrono::milliseconds(1), [&] {
+            return group.pending.load(memory_order_acquire) == 0 || queued.load(memory_order_acquire) > 0;
+        });
+    }
+}
+
+void ThreadPool::parallelFor(int begin, int end, const function<void(int)>& fn, int grain) {
+    if (begin >= end) return;
+    grain = max(1, grain);
+    if (workers.empty() || end - begin <= grain) {
+        for (int i = begin; i < end; ++i) fn(i);
+        return;
+    }
+
+    TaskGroup group;
+    for (int lo = begin; lo < end; lo += grain) {
+        const int hi = min(end, lo + grain);
+        submit(group, [&fn, lo, hi] {
+            for (int i = lo; i < hi; ++i) fn(i);
+        });
+    }
+    wait(group);
+}
+
+void ThreadPool::workerLoop(int index) {
+    tlsPool = this;
+    tlsIndex = index;
+    while (true) {
+        if (tryRun(index)) continue;
+
+        unique_lock<mutex> guard(sleepLock);
+        if (stopping) return;
+        wake.wait(guard, [&] { return stopping || queued.load(memory_order_acquire) > 0; });
+        if (stopping && queued.load(memory_order_acquire) == 0) return;
+    }
+}
+
+void ThreadPool::setDefaultThreads(int threads) {
+    requestedThreads = threads;
+}
+
+int ThreadPool::defaultThreads() {
+    if (requestedThreads > 0) return requestedThreads;
+    unsigned hw = thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<int>(hw);
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(defaultThreads());
+    return pool;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Every worker owns a deque: it pushes and pops its
+// own work at the back and steals from the front of the others. Threads that
+// wait for a TaskGroup keep executing queued tasks, so nested parallel loops
+// never deadlock and the calling thread counts as one of the pool's threads.
+class ThreadPool {
+public:
+    class TaskGroup {
+    public:
+        TaskGroup() : pending(0) {}
+    private:
+        friend class ThreadPool;
+        std::atomic<int> pending;
+    };
+
+    // threads = total threads including the caller; 1 runs everything inline.
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    void submit(TaskGroup& group, std::function<void()> task);
+    void wait(TaskGroup& group);
+
+    // Runs fn(i) for every i in [begin, end), grain indices per task, and waits.
+    void parallelFor(int begin, int end, const std::function<void(int)>& fn, int grain = 1);
+
+    // Process-wide pool; its size is fixed by setDefaultThreads before first use.
+    static ThreadPool& shared();
+    static void setDefaultThreads(int threads);
+    static int defaultThreads();
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup* group;
+    };
+
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<Queue>> queues;   // one per worker + one for outside threads
+    std::atomic<int> queued;
+    std::atomic<unsigned> nextQueue;
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool stopping;
+
+    int currentIndex() const;
+    bool tryRun(int self);
+    bool popTask(int self, Task& out);
+    void execute(Task& task);
+    void workerLoop(int index);
+};
@@ -1,28 +1,57 @@
 #include "GraphGenerator.h"
+#include "GraphFile.h"
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
+#include <string>
+#include <vector>
 
 using namespace std;
 
 int main(int argc, char* argv[]) {
+    // Options may appear anywhere; everything else is positional.
+    bool binary = false;
+    vector<string> args;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--binary") {
+            binary = true;
+        }
+        else if (arg == "--convert") {
+            // Text input file -> binary file, no generation.
+            if (i + 2 >= argc) {
+                cerr << "Usage: " << argv[0] << " --convert <input.txt> <output.bin>" << endl;
+                return 1;
+            }
+            BitMatrix G, H;
+            if (!GraphFile::loadText(argv[i + 1], G, H) || !GraphFile::saveBinary(argv[i + 2], G, H)) {
+                return 1;
+            }
+            cout << "Converted " << argv[i + 1] << " (G(" << G.rows() << "), H(" << H.rows() << ")) to " << argv[i + 2] << endl;
+            return 0;
+        }
+        else {
+            args.push_back(arg);
+        }
+    }
+
     srand(static_cast<unsigned int>(time(0)));
 
     int N_G = 5;
     int N_H = 8;
 
-    if (argc == 3) {
+    if (args.size() == 2) {
         try {
-            N_G = stoi(argv[1]);
-            N_H = stoi(argv[2]);
+            N_G = stoi(args[0]);
+            N_H = stoi(args[1]);
         }
         catch (...) {
-            cerr << "Error: Invalid arguments. Usage: " << argv[0] << " {size V(G)} {size V(H)}" << endl;
+            cerr << "Error: Invalid arguments. Usage: " << argv[0] << " {size V(G)} {size V(H)} [--binary]" << endl;
             return 1;
         }
     }
-    else if (argc > 1) {
-        cout << "Usage: " << argv[0] << " {size V(G)} {size V(H)}" << endl;
+    else if (!args.empty()) {
+        cout << "Usage: " << argv[0] << " {size V(G)} {size V(H)} [--binary]" << endl;
         cout << "Using default sizes: " << N_G << ", " << N_H << endl;
     }
 
@@ -36,8 +65,13 @@ int main(int argc, char* argv[]) {
     auto G = GraphGenerator::generateConnectedGraph(N_G, density_G);
     auto H = GraphGenerator::generateConnectedGraph(N_H, density_H);
 
-    string filename = "graphs.txt";
-    GraphGenerator::saveGraphsToFile(filename, G, H);
+    string filename = binary ? "graphs.bin" : "graphs.txt";
+    if (binary) {
+        GraphGenerator::saveGraphsToBinaryFile(filename, G, H);
+    }
+    else {
+        GraphGenerator::saveGraphsToFile(filename, G, H);
+    }
 
     cout << "Generated graphs: G(" << N_G << ") and H(" << N_H << ")" << endl;
     cout << "Saved to: " << filename << endl;
@@ -1,239 +1,24 @@
 #include "Graph.h"
-#include "HungarianAlgorithm.h"
+#include "Solver.h"
+#include "ThreadPool.h"
+#include "Stats.h"
 #include <iostream>
 #include <vector>
 #include <chrono>
 #include <algorithm>
 #include <string>
 #include <iomanip>
-#include <climits>
-#include <unordered_map>
 #include <sstream>
-#include <functional>
+#include <fstream>
+#include <mutex>
+#include <cstdio>
+#include <filesystem>
+#include <exception>
 
 using namespace std;
 
-struct BestPerSet {
-    int dist;
-    vector<int> mapping;
-};
-
-struct ApproxResult {
-    int numCopies;         
-    int totalExtEdges;     
-    vector<vector<int>> extendedH;
-    double hungarianTime;
-};
-
-struct SolveResult {
-    Graph H_ext;
-    double duration_sec = 0.0;
-
-    int edgesG = 0;
-    int edgesH = 0;
-    int edgesHext = 0;
-
-    int copiesRequested = 1;
-    int copiesFound = 0;
-    int totalEdgesAdded = 0;
-
-    int bestDistance = INT_MAX;
-    std::vector<int> bestMapping;
-    bool isSubgraph = false;
-};
-
-struct Candidate {
-    int dist;
-    vector<int> mapping;
-};
-
-vector<int> computeDegrees(const vector<vector<int>>& adj);
-
-int evaluateMapping(const Graph& G, const Graph& H, const vector<int>& mapping) { // Returns number of edges needed to add to H 
-    //to accommodate G under the given mapping
-    int edgesNeeded = 0;
-    for (int i = 0; i < G.size; ++i) {
-        for (int j = 0; j < G.size; ++j) {
-            if (G.adj[i][j] == 1) {
-                int hi = mapping[i];
-                int hj = mapping[j];
-                if (H.adj[hi][hj] == 0) {
-                    edgesNeeded++;
-                }
-            }
-        }
-    }
-    return edgesNeeded;
-}
-
-
-pair<bool, vector<int>> hungarianMappingOne(
-    const Graph& G,
-    const Graph& H,
-    const vector<bool>* forbidColsRow0 = nullptr // if provided, columns marked true are forbidden for row 0
-) {
-    int n = G.size;
-    int m = H.size;
-
-    if (n > m) {
-        return { false, {} };
-    }
-
-    HungarianAlgorithm hungarian(m); // build square assignment matrix of size m x m
-
-    vector<int> degG = computeDegrees(G.adj);
-    vector<int> degH = computeDegrees(H.adj);
-
-    const int FORBIDDEN = 1'000'000;
-
-    for (int i = 0; i < m; ++i) {
-        for (int j = 0; j < m; ++j) {
-            if (i < n) {
-                // If we want to force a different vertex-set than some previous one:
-                // forbid ALL vertices of that set for row 0, guaranteeing ≥1 vertex differs.
-                if (i == 0 && forbidColsRow0 && j < (int)forbidColsRow0->size() && (*forbidColsRow0)[j]) {
-                    hungarian.setCost(i, j, FORBIDDEN);
-                    continue;
-                }
-
-                int cost = 0;
-
-                for (int k = 0; k < n; ++k) {
-                    if (i != k) {
-                        if (G.adj[i][k] == 1) {
-                            int outDegreeH = 0;
-                            for (int l = 0; l < m; ++l) {
-                                if (H.adj[j][l] == 1) outDegreeH++;
-                            }
-                            if (outDegreeH == 0) cost += 20;
-                        }
-                        if (G.adj[k][i] == 1) {
-                            int inDegreeH = 0;
-                            for (int l = 0; l < m; ++l) {
-                                if (H.adj[l][j] == 1) inDegreeH++;
-                            }
-                            if (inDegreeH == 0) cost += 20;
-                        }
-                    }
-                }
-
-                cost += abs(degG[i] - degH[j]);
-                cost += (i + j) / 10;
-
-                hungarian.setCost(i, j, cost + 1);
-            }
-            else {
-                hungarian.setCost(i, j, 0);
-            }
-        }
-    }
-
-    vector<int> assignment = hungarian.findMinCostAssignment();
-
-    vector<int> mapping(n);
-    for (int i = 0; i < n; ++i) {
-        mapping[i] = assignment[i];
-        if (mapping[i] < 0 || mapping[i] >= m) {
-            return { false, {} };
-        }
-    }
-
-    return { true, mapping };
-}
-
-
-
-ApproxResult hungarianApproximateExtendMany(const Graph& G, const Graph& H, int targetCopies = -1) {
-    ApproxResult result;
-    result.numCopies = 0;
-    result.totalExtEdges = 0;
-    result.extendedH = H.adj;
-
-    auto start = chrono::high_resolution_clock::now();
-
-    const int n = G.size;
-    const int m = H.size;
-
-    if (n > m) {
-        auto end = chrono::high_resolution_clock::now();
-        result.hungarianTime = chrono::duration<double, milli>(end - start).count();
-        return result;
-    }
-
-    // Store only the *vertex sets* used by accepted copies (order-independent).
-    vector<vector<int>> previousVertexSets;
-
-    while (targetCopies == -1 || result.numCopies < targetCopies) {
-        Graph tempH(m);
-        tempH.adj = result.extendedH;
-
-        // 1) Get a Hungarian mapping
-        auto mappingResult = hungarianMappingOne(G, tempH, nullptr);
-        if (!mappingResult.first) break;
-
-        vector<int> mapping = mappingResult.second;
-
-        // 2) Normalize to a vertex-set (sorted) for the "distinct copy" rule
-        vector<int> vertexSet = mapping;
-        sort(vertexSet.begin(), vertexSet.end());
-
-        // 3) If this vertex-set equals any previous one, force a change:
-        //    forbid ALL vertices of that set for row 0 -> guarantees at least one vertex differs.
-        int safety = 0;
-        while (true) {
-            bool duplicate = false;
-            for (const auto& prevSet : previousVertexSets) {
-                if (prevSet == vertexSet) { duplicate = true; break; }
-            }
-            if (!duplicate) break;
-
-            vector<bool> forbidCols(m, false);
-            for (int v : vertexSet) forbidCols[v] = true;
-
-            auto altRes = hungarianMappingOne(G, tempH, &forbidCols);
-            if (!altRes.first) {
-                // No alternative mapping that differs by ≥1 vertex exists
-                safety = 1000;
-                break;
-            }
-
-            mapping = altRes.second;
-            vertexSet = mapping;
-            sort(vertexSet.begin(), vertexSet.end());
-
-            if (++safety > 1000) break;
-        }
-
-        if (safety >= 1000) break;
-
-        // 4) Accept mapping and extend H (edges may overlap; count only newly added edges)
-        int edgesAdded = 0;
-        for (int i = 0; i < n; ++i) {
-            for (int j = 0; j < n; ++j) {
-                if (G.adj[i][j] == 1) {
-                    int hi = mapping[i];
-                    int hj = mapping[j];
-                    if (result.extendedH[hi][hj] == 0) {
-                        result.extendedH[hi][hj] = 1;
-                        edgesAdded++;
-                    }
-                }
-            }
-        }
-
-        result.totalExtEdges += edgesAdded;
-        result.numCopies++;
-
-        previousVertexSets.push_back(vertexSet);
-    }
-
-    auto end = chrono::high_resolution_clock::now();
-    result.hungarianTime = chrono::duration<double, milli>(end - start).count();
-
-    return result;
-}
-
-void runApproximation(const Graph& G, const Graph& H, int targetCopies = -1) {
+void runApproximation(const Graph& G, const Graph& H, int targetCopies = -1,
+                      const SolverOptions& options = SolverOptions()) {
     cout << "\n=== HUNGARIAN ALGORITHM RESULTS ===" << endl;
     if (targetCopies > 0) {
         cout << "Target copies requested: " << targetCopies << endl;
@@ -242,30 +27,16 @@ void runApproximation(const Graph& G, const Graph& H, int targetCopies = -1) {
         cout << "Target copies: maximum possible" << endl;
     }
 
-    int gEdges = 0, hEdges = 0;
-    for (int i = 0; i < G.size; ++i) {
-        for (int j = 0; j < G.size; ++j) {
-            gEdges += G.adj[i][j];
-        }
-    }
-    for (int i = 0; i < H.size; ++i) {
-        for (int j = 0; j < H.size; ++j) {
-            hEdges += H.adj[i][j];
-        }
-    }
+    int gEdges = G.edgeCount();
+    int hEdges = H.edgeCount();
 
-    ApproxResult hungarianResult = hungarianApproximateExtendMany(G, H, targetCopies);
+    ApproxResult hungarianResult = hungarianApproximateExtendMany(G, H, targetCopies, options);
 
     cout << "Size of G (edges):          " << gEdges << endl;
     cout << "Size of H before (edges):   " << hEdges << endl;
 
 
-    int extendedEdges = 0;
-    for (const auto& row : hungarianResult.extendedH) {
-        for (int edge : row) {
-            extendedEdges += edge;
-        }
-    }
+    int extendedEdges = hungarianResult.extendedH.edgeCount();
 
     cout << "Size of H after (edges):    " << extendedEdges << endl;
     cout << "Edges added (extension size): " << hungarianResult.totalExtEdges << endl;
@@ -279,186 +50,8 @@ void runApproximation(const Graph& G, const Graph& H, int targetCopies = -1) {
     }
 }
 
-SolveResult runHungarian(const Graph& G, const Graph& H, int targetCopies = -1) {
-    SolveResult res{};
-    res.edgesG = G.edgeCount();
-    res.edgesH = H.edgeCount();
-
-    res.copiesRequested = targetCopies;
-
-    ApproxResult a = hungarianApproximateExtendMany(G, H, targetCopies);
-
-    res.copiesFound = a.numCopies;
-    res.totalEdgesAdded = a.totalExtEdges;
-
-
-    res.duration_sec = a.hungarianTime / 1000.0;
-
-    Graph H_ext(H.size);
-    H_ext.adj = a.extendedH;
-
-    res.H_ext = H_ext;
-    res.edgesHext = H_ext.edgeCount();
-
-    res.bestDistance = INT_MAX;
-    res.isSubgraph = false;
-
-    return res;
-}
-
-static int ExtendGraph(const Graph& G, Graph& H_ext, const std::vector<int>& mapping) {
-    const int n = G.size;
-    int added = 0;
-
-    for (int uG = 0; uG < n; ++uG) {
-        int uH = mapping[uG];
-        for (int vG = 0; vG < n; ++vG) {
-            if (G.adj[uG][vG] > 0) {
-                int vH = mapping[vG];
-                if (H_ext.adj[uH][vH] == 0) {
-                    H_ext.adj[uH][vH] = 1;
-                    added++;
-                }
-            }
-        }
-    }
-    return added;
-}
-
-
-SolveResult ExactMinExtendGraph(const Graph& G, const Graph& H, int targetCopies) {
-    using namespace std;
-    using namespace std::chrono;
-
-    SolveResult res{};
-    res.edgesG = G.edgeCount();
-    res.edgesH = H.edgeCount();
-
-    auto start = high_resolution_clock::now();
-    Graph H_ext = H;
-    if (targetCopies == 1) {
-        auto result = G.FindBestMapping(H);
-        res.bestMapping = result.first;
-        res.bestDistance = result.second;
-
-        
-        if (res.bestDistance != 0 && res.bestDistance != INT_MAX) {
-            ExtendGraph(G, H_ext, res.bestMapping);
-        }
-
-        res.isSubgraph = (res.bestDistance == 0);
-        res.copiesFound = (res.bestDistance == INT_MAX ? 0 : 1);
-        res.H_ext = H_ext;
-        res.edgesHext = H_ext.edgeCount();
-        res.totalEdgesAdded = res.edgesHext - res.edgesH;
-
-    }
-    else {
-
-        const int n = G.size;
-        const int m = H.size;
-        auto distanceUnderMapping = [&](const Graph& Hcur, const vector<int>& mapping) -> int {
-            int dist = 0;
-            for (int uG = 0; uG < n; ++uG) {
-                int uH = mapping[uG];
-                for (int vG = 0; vG < n; ++vG) {
-                    if (G.adj[uG][vG] > 0) {
-                        int vH = mapping[vG];
-                        if (Hcur.adj[uH][vH] == 0) dist++;
-                    }
-                }
-            }
-            return dist;
-            };
-
-        auto vertexSetKey = [&](const vector<int>& mapping) -> string {
-            vector<int> s = mapping;
-            sort(s.begin(), s.end());
-            ostringstream oss;
-            for (int i = 0; i < (int)s.size(); ++i) {
-                if (i) oss << ',';
-                oss << s[i];
-            }
-            return oss.str();
-            };
-
-        
-
-        unordered_map<string, BestPerSet> bestForSet;
-        bestForSet.reserve(1024);
-        vector<int> mapping(n, -1);
-        vector<char> usedH(m, false);
-
-        function<void(int)> dfs = [&](int uG) {
-            if (uG == n) {
-                int d = distanceUnderMapping(H, mapping);
-                string key = vertexSetKey(mapping);
-
-                auto it = bestForSet.find(key);
-                if (it == bestForSet.end() || d < it->second.dist) {
-                    bestForSet[key] = BestPerSet{ d, mapping };
-                }
-                return;
-            }
-
-            for (int vH = 0; vH < m; ++vH) {
-                if (usedH[vH]) continue;
-                usedH[vH] = true;
-                mapping[uG] = vH;
-                dfs(uG + 1);
-                mapping[uG] = -1;
-                usedH[vH] = false;
-            }
-            };
-
-        dfs(0);
-
-        vector<Candidate> cand;
-        cand.reserve(bestForSet.size());
-        for (auto& kv : bestForSet) {
-            cand.push_back(Candidate{ kv.second.dist, kv.second.mapping });
-        }
-
-        sort(cand.begin(), cand.end(), [](const Candidate& a, const Candidate& b) {
-            return a.dist < b.dist;
-            });
-
-        int copiesFound = min(targetCopies, (int)cand.size());
-
-        int edgesAddedTotal = 0;
-
-        for (int idx = 0; idx < copiesFound; ++idx) {
-            const auto& mapGtoH = cand[idx].mapping;
-
-            for (int uG = 0; uG < n; ++uG) {
-                int uH = mapGtoH[uG];
-                for (int vG = 0; vG < n; ++vG) {
-                    if (G.adj[uG][vG] > 0) {
-                        int vH = mapGtoH[vG];
-                        if (H_ext.adj[uH][vH] == 0) {
-                            H_ext.adj[uH][vH] = 1;
-                            edgesAddedTotal++;
-                        }
-                    }
-                }
-            }
-        }
-
-        res.H_ext = H_ext;
-        res.edgesHext = H_ext.edgeCount();
-        res.totalEdgesAdded = edgesAddedTotal;
-        res.copiesFound = copiesFound;
-        res.isSubgraph = false;
-        res.bestDistance = INT_MAX;
-    }
-
-    auto end = high_resolution_clock::now();
-    res.duration_sec = duration_cast<duration<double>>(end - start).count();
-    return res;
-}
-
 void displayResultsForSmallGraphs(std::string algo, Graph G, Graph H, Graph H_ext, double duration) {
-    cout << "=== " << (algo == "exact" ? "EXACT" : "HUNGARIAN") << " ALGORITHM RESULTS ===" << endl;
+    cout << "=== " << (algo == "exact" ? "EXACT" : algo == "auction" ? "AUCTION" : algo == "anneal" ? "ANNEALING" : "HUNGARIAN") << " ALGORITHM RESULTS ===" << endl;
     cout << "Algorithm time: " << fixed << setprecision(6) << duration << "ms" << endl << endl;
 
     cout << "-- Graph G --" << endl;
@@ -471,8 +64,8 @@ void displayResultsForSmallGraphs(std::string algo, Graph G, Graph H, Graph H_ex
     int n = std::max(H.size, H_ext.size);
     for (int i = 0; i < n; ++i) {
         for (int j = 0; j < n; ++j) {
-            int oldVal = (i < H.size && j < H.size) ? H.adj[i][j] : 0;
-            int newVal = (i < H_ext.size && j < H_ext.size) ? H_ext.adj[i][j] : 0;
+            int oldVal = (i < H.size && j < H.size) ? H.hasEdge(i, j) : 0;
+            int newVal = (i < H_ext.size && j < H_ext.size) ? H_ext.hasEdge(i, j) : 0;
             if (newVal != 0 && oldVal == 0) addedEdges++;
         }
     }
@@ -486,7 +79,7 @@ void displayResultsForSmallGraphs(std::string algo, Graph G, Graph H, Graph H_ex
 }
 
 void displayResultsForBigGraphs(std::string algo, int EdgesG, int EdgesH, int EdgesH_ext, double duration) {
-    cout << "=== " << (algo == "exact" ? "EXACT" : "HUNGARIAN") << " ALGORITHM RESULTS (BIG GRAPHS) ===" << endl;
+    cout << "=== " << (algo == "exact" ? "EXACT" : algo == "auction" ? "AUCTION" : algo == "anneal" ? "ANNEALING" : "HUNGARIAN") << " ALGORITHM RESULTS (BIG GRAPHS) ===" << endl;
     cout << "Algorithm time: " << fixed << setprecision(6) << duration << " s" << endl;
 
     cout << "\nEdge counts:" << endl;
@@ -509,10 +102,357 @@ void displayResultsForBigGraphs(std::string algo, int EdgesG, int EdgesH, int Ed
     cout << "============================================================" << endl;
 }
 
+// One instance of a batch run and, once solved, its output record.
+struct BatchInstance {
+    string file;
+    string algorithm;
+    int targetCopies = -1;
+
+    bool ok = false;
+    bool stoppedEarly = false;
+    int verticesG = 0, edgesG = 0, verticesH = 0, edgesH = 0;
+    int copiesFound = 0, edgesAdded = 0;
+    double loadSec = 0.0, solveSec = 0.0;
+};
+
+// Instances from a manifest (one "<input_file> [algorithm] [copies]" per line,
+// '#' starts a comment, relative paths are taken from the manifest's directory)
+// or from every regular file in a directory, in name order. Missing fields use
+// the command-line defaults.
+static bool readBatchInstances(const string& source, const string& algorithm, int targetCopies,
+                               vector<BatchInstance>& out) {
+    namespace fs = std::filesystem;
+    error_code ec;
+    if (fs::is_directory(source, ec)) {
+        vector<string> files;
+        for (const auto& entry : fs::directory_iterator(source, ec)) {
+            if (entry.is_regular_file() && entry.path().filename().string()[0] != '.') {
+                files.push_back(entry.path().string());
+            }
+        }
+        sort(files.begin(), files.end());
+        for (const string& f : files) out.push_back(BatchInstance{ f, algorithm, targetCopies });
+        return true;
+    }
+
+    ifstream manifest(source);
+    if (!manifest.is_open()) {
+        cerr << "Error: Could not open batch manifest " << source << endl;
+        return false;
+    }
+    const fs::path base = fs::path(source).parent_path();
+    string line;
+    for (int lineNo = 1; getline(manifest, line); ++lineNo) {
+        line = line.substr(0, line.find('#'));
+        istringstream fields(line);
+        BatchInstance inst{ "", algorithm, targetCopies };
+        if (!(fields >> inst.file)) continue;
+        if (fields >> inst.algorithm) {
+            transform(inst.algorithm.begin(), inst.algorithm.end(), inst.algorithm.begin(), ::tolower);
+            string copies;
+            if (fields >> copies) {
+                try {
+                    inst.targetCopies = stoi(copies);
+                }
+                catch (...) {
+                    cerr << "Error: " << source << ":" << lineNo << ": invalid number of copies '" << copies << "'" << endl;
+                    return false;
+                }
+            }
+        }
+        if (!isKnownAlgorithm(inst.algorithm)) {
+            cerr << "Error: " << source << ":" << lineNo << ": unknown algorithm '" << inst.algorithm << "'" << endl;
+            return false;
+        }
+        if (fs::path(inst.file).is_relative()) inst.file = (base / inst.file).string();
+        out.push_back(std::move(inst));
+    }
+    return true;
+}
+
+static string csvField(const string& text) {
+    if (text.find_first_of(",\"\n") == string::npos) return text;
+    string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+static string jsonString(const string& text) {
+    string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            quoted += escaped;
+        }
+        else {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+static void writeBatchRecord(ostream& out, const BatchInstance& r, bool json) {
+    const char* status = r.ok ? "ok" : "error";
+    if (json) {
+        out << "{\"file\":" << jsonString(r.file) << ",\"algorithm\":" << jsonString(r.algorithm)
+            << ",\"status\":\"" << status << "\""
+            << ",\"vertices_g\":" << r.verticesG << ",\"edges_g\":" << r.edgesG
+            << ",\"vertices_h\":" << r.verticesH << ",\"edges_h\":" << r.edgesH
+            << ",\"copies_requested\":" << r.targetCopies << ",\"copies_found\":" << r.copiesFound
+            << ",\"edges_added\":" << r.edgesAdded << ",\"stopped_early\":" << (r.stoppedEarly ? "true" : "false")
+            << ",\"load_seconds\":" << r.loadSec << ",\"solve_seconds\":" << r.solveSec << "}\n";
+    }
+    else {
+        out << csvField(r.file) << "," << r.algorithm << "," << status << ","
+            << r.verticesG << "," << r.edgesG << "," << r.verticesH << "," << r.edgesH << ","
+            << r.targetCopies << "," << r.copiesFound << "," << r.edgesAdded << "," << (r.stoppedEarly ? 1 : 0) << ","
+            << r.loadSec << "," << r.solveSec << "\n";
+    }
+}
+
+// Solves every instance on the shared pool, one task per instance, and writes a
+// record per instance in input order as soon as all earlier ones are done.
+static int runBatch(vector<BatchInstance>& instances, const SolverOptions& options, ostream& out, bool json) {
+    using namespace std::chrono;
+    auto start = steady_clock::now();
+
+    out << setprecision(6);
+    if (!json) {
+        out << "file,algorithm,status,vertices_g,edges_g,vertices_h,edges_h,"
+               "copies_requested,copies_found,edges_added,stopped_early,load_seconds,solve_seconds\n";
+    }
+
+    mutex outputLock;
+    vector<char> done(instances.size(), false);
+    size_t nextToWrite = 0;
+
+    ThreadPool& pool = ThreadPool::shared();
+    ThreadPool::TaskGroup group;
+    for (size_t k = 0; k < instances.size(); ++k) {
+        pool.submit(group, [&, k] {
+            BatchInstance& inst = instances[k];
+            auto loadStart = steady_clock::now();
+            // One instance that throws, e.g. bad_alloc on a huge graph, is
+            // recorded as an error and does not take the batch down.
+            try {
+                Graph G, H;
+                if (Graph::loadPair(inst.file, G, H) && G.size > 0 && H.size > 0) {
+                    inst.loadSec = duration<double>(steady_clock::now() - loadStart).count();
+                    SolveResult res = solve(inst.algorithm, G, H, inst.targetCopies, options);
+                    inst.ok = true;
+                    inst.verticesG = G.size;
+                    inst.edgesG = res.edgesG;
+                    inst.verticesH = H.size;
+                    inst.edgesH = res.edgesH;
+                    inst.copiesFound = res.copiesFound;
+                    inst.edgesAdded = res.edgesHext - res.edgesH;
+                    inst.solveSec = res.duration_sec;
+                    inst.stoppedEarly = res.stoppedEarly;
+                }
+            }
+            catch (const exception& e) {
+                inst.ok = false;
+                lock_guard<mutex> lock(outputLock);
+                cerr << "Error: " << inst.file << ": " << e.what() << endl;
+            }
+
+            lock_guard<mutex> lock(outputLock);
+            done[k] = true;
+            while (nextToWrite < instances.size() && done[nextToWrite]) {
+                writeBatchRecord(out, instances[nextToWrite++], json);
+            }
+            out.flush();
+        });
+    }
+    pool.wait(group);
+
+    int failed = 0;
+    for (const BatchInstance& inst : instances) failed += inst.ok ? 0 : 1;
+    cerr << "Batch: " << instances.size() - failed << " of " << instances.size() << " instances solved in "
+         << fixed << setprecision(3) << duration<double>(steady_clock::now() - start).count() << " s on "
+         << pool.size() << " threads" << endl;
+    return failed == 0 ? 0 : 1;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        cerr << "Usage: " << argv[0] << " [algorithm] <input_file> [number_of_copies]" << endl;
-        cerr << "Algorithms: exact | hungarian" << endl;
+    // Options may appear anywhere; everything else is positional.
+    vector<string> args;
+    SolverOptions options;
+    string batchSource, outputFile, outputFormat, statsFormat;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            try {
+                ThreadPool::setDefaultThreads(stoi(argv[++i]));
+            }
+            catch (...) {
+                cerr << "Error: invalid thread count '" << argv[i] << "'" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--epsilon" && i + 1 < argc) {
+            try {
+                options.epsilon = stod(argv[++i]);
+            }
+            catch (...) {
+                cerr << "Error: invalid epsilon '" << argv[i] << "'" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--portfolio" && i + 1 < argc) {
+            try {
+                options.portfolio = stoi(argv[++i]);
+            }
+            catch (...) {
+                cerr << "Error: invalid portfolio size '" << argv[i] << "'" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--refine") {
+            options.refine = true;
+        }
+        else if (arg == "--iterations" && i + 1 < argc) {
+            try {
+                options.iterations = stoll(argv[++i]);
+            }
+            catch (...) {
+                cerr << "Error: invalid iteration count '" << argv[i] << "'" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            try {
+                options.seed = static_cast<unsigned>(stoul(argv[++i]));
+            }
+            catch (...) {
+                cerr << "Error: invalid seed '" << argv[i] << "'" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--time-limit" && i + 1 < argc) {
+            try {
+                options.timeLimit = stod(argv[++i]);
+            }
+            catch (...) {
+                cerr << "Error: invalid time limit '" << argv[i] << "'" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--node-limit" && i + 1 < argc) {
+            try {
+                options.nodeLimit = stoll(argv[++i]);
+            }
+            catch (...) {
+                cerr << "Error: invalid node limit '" << argv[i] << "'" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--bound" && i + 1 < argc) {
+            const string bound = argv[++i];
+            if (bound != "simple" && bound != "assignment") {
+                cerr << "Error: unknown bound '" << bound << "' (simple or assignment)" << endl;
+                return 1;
+            }
+            options.assignmentBound = (bound == "assignment");
+        }
+        else if (arg == "--stats" && i + 1 < argc) {
+            statsFormat = argv[++i];
+            if (statsFormat != "text" && statsFormat != "json") {
+                cerr << "Error: unknown stats format '" << statsFormat << "' (text or json)" << endl;
+                return 1;
+            }
+#ifndef SOLVER_STATS
+            cerr << "Warning: --stats needs a build with -DSOLVER_STATS; no statistics are collected." << endl;
+            statsFormat.clear();
+#endif
+        }
+        else if (arg == "--batch" && i + 1 < argc) {
+            batchSource = argv[++i];
+        }
+        else if (arg == "--output" && i + 1 < argc) {
+            outputFile = argv[++i];
+        }
+        else if (arg == "--format" && i + 1 < argc) {
+            outputFormat = argv[++i];
+            if (outputFormat != "csv" && outputFormat != "jsonl") {
+                cerr << "Error: unknown output format '" << outputFormat << "' (csv or jsonl)" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--candidates" && i + 1 < argc) {
+            try {
+                options.candidates = stoi(argv[++i]);
+            }
+            catch (...) {
+                cerr << "Error: invalid candidate count '" << argv[i] << "'" << endl;
+                return 1;
+            }
+        }
+        else {
+            args.push_back(arg);
+        }
+    }
+
+    if (!batchSource.empty()) {
+        // Batch: positional arguments are the default [algorithm] [number_of_copies].
+        string algorithm = args.size() >= 1 ? args[0] : "hungarian";
+        transform(algorithm.begin(), algorithm.end(), algorithm.begin(), ::tolower);
+        if (!isKnownAlgorithm(algorithm)) {
+            cerr << "Unknown algorithm: " << algorithm << endl;
+            return 1;
+        }
+        int targetCopies = -1;
+        if (args.size() >= 2) {
+            try {
+                targetCopies = stoi(args[1]);
+            }
+            catch (...) {
+                cerr << "Error: invalid number of copies '" << args[1] << "'" << endl;
+                return 1;
+            }
+        }
+
+        vector<BatchInstance> instances;
+        if (!readBatchInstances(batchSource, algorithm, targetCopies, instances)) return 1;
+
+        // Without --format, an output file ending in .jsonl / .json selects JSON lines.
+        bool json = outputFormat == "jsonl";
+        if (outputFormat.empty() && !outputFile.empty()) {
+            const string ext = std::filesystem::path(outputFile).extension().string();
+            json = (ext == ".jsonl" || ext == ".json");
+        }
+        int status;
+        if (outputFile.empty()) {
+            status = runBatch(instances, options, cout, json);
+        }
+        else {
+            ofstream out(outputFile, ios::trunc);
+            if (!out.is_open()) {
+                cerr << "Error: Could not create file " << outputFile << endl;
+                return 1;
+            }
+            status = runBatch(instances, options, out, json);
+        }
+#ifdef SOLVER_STATS
+        // Totals over all instances; kept off the console records.
+        if (!statsFormat.empty()) stats::report(outputFile.empty() ? cerr : cout, statsFormat == "json");
+#endif
+        return status;
+    }
+
+    if (args.empty()) {
+        cerr << "Usage: " << argv[0] << " [algorithm] <input_file> [number_of_copies] [--threads N] [--candidates K] [--epsilon E]"
+             << " [--portfolio K] [--refine] [--iterations N] [--seed S] [--time-limit SECONDS] [--node-limit N] [--bound simple|assignment] [--stats text|json]" << endl;
+        cerr << "       " << argv[0] << " --batch <manifest|directory> [algorithm] [number_of_copies] [--output FILE] [--format csv|jsonl]" << endl;
+        cerr << "Algorithms: exact | hungarian | auction | anneal" << endl;
         return 1;
     }
 
@@ -520,17 +460,17 @@ int main(int argc, char* argv[]) {
     string inputFile;
     int targetCopies = -1; // -1 means find maximum possible copies
 
-    if (argc == 2) {
-        inputFile = argv[1];
+    if (args.size() == 1) {
+        inputFile = args[0];
     }
-    else if (argc == 3) {
-        algorithm = argv[1];
-        inputFile = argv[2];
+    else if (args.size() == 2) {
+        algorithm = args[0];
+        inputFile = args[1];
     }
-    else if (argc == 4) {
-        algorithm = argv[1];
-        inputFile = argv[2];
-        targetCopies = stoi(argv[3]);
+    else if (args.size() >= 3) {
+        algorithm = args[0];
+        inputFile = args[1];
+        targetCopies = stoi(args[2]);
     }
 
     transform(algorithm.begin(), algorithm.end(), algorithm.begin(), ::tolower);
@@ -544,51 +484,53 @@ int main(int argc, char* argv[]) {
         cout << "Target copies: maximum possible" << endl;
     }
 
-    Graph G(inputFile, true);   // first graph
-    Graph H(inputFile, false);  // second graph
+    Graph G, H;
+    Graph::loadPair(inputFile, G, H);   // text or binary, G first
 
     if (G.size == 0 || H.size == 0) {
         cerr << "Error: failed to load graphs from '" << inputFile << "'." << endl;
         return 1;
     }
 
-    SolveResult res;
-
-    if (algorithm == "exact") {
-        if (targetCopies <= 0) {
-            res = ExactMinExtendGraph(G, H, 1);
-        }
-        else {
-            res = ExactMinExtendGraph(G, H, targetCopies);
-        }
-    }
-    else if (algorithm == "hungarian") {
-        res = runHungarian(G, H, targetCopies);
-    }
-    else {
+    if (!isKnownAlgorithm(algorithm)) {
         cerr << "Unknown algorithm: " << algorithm << endl;
         return 1;
     }
+    // Long exact runs show each better mapping as soon as it is found.
+    options.onIncumbent = [](int cost, double seconds) {
+        ostringstream line;
+        line << "Incumbent: " << cost << " edges to add (" << fixed << setprecision(3) << seconds << " s)";
+        cout << line.str() << endl;
+    };
+    SolveResult res = solve(algorithm, G, H, targetCopies, options);
 
     if (G.size > 20) {
         displayResultsForBigGraphs(algorithm, res.edgesG, res.edgesH, res.edgesHext, res.duration_sec);
 
-        if (algorithm == "hungarian" || (algorithm == "exact" && (targetCopies > 1))) {
+        if (algorithm == "hungarian" || algorithm == "auction" || algorithm == "anneal" || (algorithm == "exact" && (targetCopies > 1))) {
             cout << "Copies requested: " << (res.copiesRequested <= 0 ? -1 : res.copiesRequested) << "\n";
             cout << "Copies found:     " << res.copiesFound << "\n";
             cout << "Total edges added: " << res.totalEdgesAdded << "\n";
         }
     }
     else {
-        displayResultsForSmallGraphs(algorithm, G, H, res.H_ext, res.duration_sec);
+        displayResultsForSmallGraphs(algorithm, G, H, res.H_ext.materialize(), res.duration_sec);
 
         // Optional copies info also for small graphs
-        if (algorithm == "hungarian" || (algorithm == "exact" && (targetCopies > 1))) {
+        if (algorithm == "hungarian" || algorithm == "auction" || algorithm == "anneal" || (algorithm == "exact" && (targetCopies > 1))) {
             cout << "Copies requested: " << (res.copiesRequested <= 0 ? -1 : res.copiesRequested) << "\n";
             cout << "Copies found:     " << res.copiesFound << "\n";
             cout << "Total edges added: " << res.totalEdgesAdded << "\n";
         }
     }
 
+    if (res.stoppedEarly) {
+        cout << "Search stopped at the time/node limit: this is the best result found so far, not proven optimal." << endl;
+    }
+
+#ifdef SOLVER_STATS
+    if (!statsFormat.empty()) stats::report(cout, statsFormat == "json");
+#endif
+
     return 0;
 }
@@ -1,355 +1,432 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
+#include <map>
 #include <chrono>
-#include <cstdlib>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
 #include <iomanip>
-#include <sstream>
 #include "Graph.h"
-#include "GraphGenerator.h"
-
-
+#include "Solver.h"
+#include "ThreadPool.h"
 
 using namespace std;
 
-struct TestResult {
+// Benchmark suite for the solvers in Solver.h. Every case is solved `warmup`
+// times untimed and `trials` times timed; the report gives the median and
+// percentiles of the timed runs plus the quality of the result. Results can be
+// written as CSV (--output) and compared against an earlier CSV (--baseline):
+// a case regresses when its median is more than --tolerance percent slower, or
+// when it finds fewer copies or needs more added edges than in the baseline.
+
+struct BenchCase {
+    string id;          // unique, stable across runs: the key for baselines
     string algorithm;
-    int gSize;
-    int hSize;
-    int targetCopies;
-    int copiesFound;
-    int edgesAdded;
-    double timeMs;
-    bool timeout;
-    string status;
+    SolverOptions options;
+    Graph G;
+    Graph H;
+    double density;     // of the random graphs, 0 for the fixed ones
+    int copies;
 };
 
-class TestRunner {
-private:
-    vector<TestResult> results;
+struct BenchResult {
+    string id;
+    string algorithm;
+    int n = 0;
+    int m = 0;
+    double density = 0.0;
+    int copies = 0;
+    int trials = 0;
+    double medianMs = 0.0;
+    double p10Ms = 0.0;
+    double p90Ms = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+    int copiesFound = 0;
+    int edgesAdded = 0;
+};
 
-    TestResult runExactTest(const Graph& G, const Graph& H, int targetCopies, int timeoutMs) {
-        TestResult result;
-        result.algorithm = "Exact";
-        result.gSize = G.size;
-        result.hSize = H.size;
-        result.targetCopies = targetCopies;
-        result.timeout = false;
+struct BenchSettings {
+    int warmup = 1;
+    int trials = 5;
+    bool quick = false;
+    string filter;
+    string outputFile;
+    string baselineFile;
+    double tolerancePct = 10.0;
+    // Differences below this are timer noise, whatever the ratio.
+    double noiseFloorMs = 0.1;
+};
 
-        auto start = chrono::high_resolution_clock::now();
+// Percentile of sorted samples with linear interpolation between ranks.
+static double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const double rank = p / 100.0 * (sorted.size() - 1);
+    const size_t lo = static_cast<size_t>(rank);
+    const size_t hi = min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+}
 
-        try {
-            if (targetCopies == 1) {
-                auto mapping = G.findBestMapping(H);
-                auto end = chrono::high_resolution_clock::now();
-                result.timeMs = chrono::duration<double, milli>(end - start).count();
-
-                if (result.timeMs > timeoutMs) {
-                    result.timeout = true;
-                    result.status = "TIMEOUT";
-                } else {
-                    result.edgesAdded = mapping.second;
-                    result.copiesFound = (mapping.second == INT_MAX) ? 0 : 1;
-                    result.status = "OK";
-                }
-            } else {
-                Graph tempG = G;
-                Graph tempH = H;
-                
-                streambuf* orig = cout.rdbuf();
-                stringstream buffer;
-                cout.rdbuf(buffer.rdbuf());
-                
-                tempG.exactMinExtendGraph(tempH, targetCopies);
-                
-                cout.rdbuf(orig);
-                
-                auto end = chrono::high_resolution_clock::now();
-                result.timeMs = chrono::duration<double, milli>(end - start).count();
-
-                if (result.timeMs > timeoutMs) {
-                    result.timeout = true;
-                    result.status = "TIMEOUT";
-                    result.copiesFound = 0;
-                    result.edgesAdded = 0;
-                } else {
-                    string output = buffer.str();
-                    size_t copiesPos = output.find("Copies found: ");
-                    size_t edgesPos = output.find("Total edges added: ");
-                    
-                    if (copiesPos != string::npos && edgesPos != string::npos) {
-                        result.copiesFound = stoi(output.substr(copiesPos + 14));
-                        result.edgesAdded = stoi(output.substr(edgesPos + 19));
-                        result.status = "OK";
-                    } else {
-                        result.copiesFound = min(targetCopies, H.size / G.size);
-                        result.edgesAdded = 0;
-                        result.status = "OK";
-                    }
-                }
+class TestRunner {
+private:
+    BenchSettings settings;
+    vector<BenchCase> cases;
+    vector<BenchResult> results;
+
+    // Random digraph without loops; mt19937 output is fixed by the standard, so
+    // the same seed gives the same graph on every platform.
+    static Graph randomGraph(int n, double density, uint32_t seed) {
+        mt19937 rng(seed);
+        const uint64_t threshold = static_cast<uint64_t>(density * 4294967296.0);
+        Graph g(n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (i != j && rng() < threshold) g.addEdge(i, j);
             }
-        } catch (...) {
-            result.timeout = true;
-            result.status = "ERROR";
-            result.timeMs = timeoutMs + 1;
         }
-
-        return result;
+        return g;
     }
 
-    TestResult runApproximationTest(const Graph& G, const Graph& H, int targetCopies) {
-        TestResult hungarianResult;
-
-        hungarianResult.algorithm = "Hungarian";
-        hungarianResult.gSize = G.size;
-        hungarianResult.hSize = H.size;
-        hungarianResult.targetCopies = targetCopies;
-
-        auto start = chrono::high_resolution_clock::now();
-
-        try {
-            Graph extendedH = H;
-            vector<bool> usedH(H.size, false);
-            int totalEdgesAdded = 0;
-            int copiesFound = 0;
-            
-            int maxCopies = (targetCopies == -1) ? H.size / G.size : targetCopies;
-            
-            for (int copyNum = 0; copyNum < maxCopies; ++copyNum) {
-                int available = 0;
-                for (bool used : usedH) {
-                    if (!used) available++;
-                }
-                
-                if (available < G.size) break;
-                
-                auto mappingResult = Graph::hungarianMappingOne(G, extendedH, usedH);
-                if (!mappingResult.first) break;
-                
-                vector<int> mapping = mappingResult.second;
-                
-                for (int node : mapping) {
-                    usedH[node] = true;
-                }
-                
-                int edgesAdded = 0;
-                for (int i = 0; i < G.size; ++i) {
-                    for (int j = 0; j < G.size; ++j) {
-                        if (G.adj[i][j] == 1) {
-                            int hi = mapping[i];
-                            int hj = mapping[j];
-                            if (extendedH.adj[hi][hj] == 0) {
-                                extendedH.adj[hi][hj] = 1;
-                                edgesAdded++;
-                            }
-                        }
-                    }
-                }
-                
-                totalEdgesAdded += edgesAdded;
-                copiesFound++;
-            }
+    static string caseId(const string& algorithm, const string& kind, int n, int m, double density, int copies) {
+        char id[128];
+        snprintf(id, sizeof(id), "%s/%s/n%d-m%d-d%.2f-c%d", algorithm.c_str(), kind.c_str(), n, m, density, copies);
+        return id;
+    }
 
-            auto end = chrono::high_resolution_clock::now();
-            hungarianResult.timeMs = chrono::duration<double, milli>(end - start).count();
-            hungarianResult.timeout = false;
-            hungarianResult.edgesAdded = totalEdgesAdded;
-            hungarianResult.copiesFound = copiesFound;
-            hungarianResult.status = (targetCopies == -1 || copiesFound >= targetCopies) ? "TARGET_MET" : "TARGET_MISSED";
-
-        } catch (...) {
-            hungarianResult.timeout = true;
-            hungarianResult.status = "ERROR";
-            hungarianResult.edgesAdded = 0;
-            hungarianResult.copiesFound = 0;
+    // variant is appended to the algorithm in the case id (e.g. "+refine").
+    void addCase(const string& algorithm, const string& kind, const Graph& G, const Graph& H, double density, int copies,
+                 const SolverOptions& options = SolverOptions(), const string& variant = "") {
+        BenchCase c{ caseId(algorithm + variant, kind, G.size, H.size, density, copies), algorithm, options, G, H, density, copies };
+        if (settings.filter.empty() || c.id.find(settings.filter) != string::npos) {
+            cases.push_back(std::move(c));
         }
-
-        return hungarianResult;
     }
 
     pair<Graph, Graph> createFixedGraphs(int gSize, int hSize) {
         Graph G(gSize), H(hSize);
-        
+
         if (gSize == 3 && hSize == 5) {
-            G.adj = {{0, 1, 0}, {0, 0, 1}, {1, 0, 0}};
-            H.adj = {{0, 1, 0, 0, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 0}, 
-                     {0, 0, 0, 0, 1}, {1, 0, 0, 0, 0}};
+            G = Graph(vector<vector<int>>{{0, 1, 0}, {0, 0, 1}, {1, 0, 0}});
+            H = Graph(vector<vector<int>>{{0, 1, 0, 0, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 0},
+                     {0, 0, 0, 0, 1}, {1, 0, 0, 0, 0}});
         } else if (gSize == 4 && hSize == 6) {
-            G.adj = {{0, 1, 0, 0}, {0, 0, 1, 1}, {0, 0, 0, 0}, {1, 0, 0, 0}};
-            H.adj = {{0, 1, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 1, 0, 0}, 
-                     {0, 0, 0, 0, 1, 0}, {0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 0, 0}};
+            G = Graph(vector<vector<int>>{{0, 1, 0, 0}, {0, 0, 1, 1}, {0, 0, 0, 0}, {1, 0, 0, 0}});
+            H = Graph(vector<vector<int>>{{0, 1, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 1, 0, 0},
+                     {0, 0, 0, 0, 1, 0}, {0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 0, 0}});
         } else if (gSize == 5 && hSize == 8) {
-            G.adj = {{0, 1, 0, 0, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 1}, 
-                     {0, 0, 0, 0, 1}, {1, 0, 0, 0, 0}};
-            H.adj = {{0, 1, 0, 0, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0, 0, 0}, 
-                     {0, 0, 0, 1, 0, 0, 0, 0}, {0, 0, 0, 0, 1, 0, 0, 0}, 
-                     {0, 0, 0, 0, 0, 1, 0, 0}, {0, 0, 0, 0, 0, 0, 1, 0}, 
-                     {0, 0, 0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 1, 0, 0, 0}};
+            G = Graph(vector<vector<int>>{{0, 1, 0, 0, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 1},
+                     {0, 0, 0, 0, 1}, {1, 0, 0, 0, 0}});
+            H = Graph(vector<vector<int>>{{0, 1, 0, 0, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0, 0, 0},
+                     {0, 0, 0, 1, 0, 0, 0, 0}, {0, 0, 0, 0, 1, 0, 0, 0},
+                     {0, 0, 0, 0, 0, 1, 0, 0}, {0, 0, 0, 0, 0, 0, 1, 0},
+                     {0, 0, 0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 1, 0, 0, 0}});
         } else if (gSize == 6 && hSize == 10) {
-            G.adj = {{0, 1, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 1, 0, 0}, 
-                     {0, 0, 0, 0, 1, 0}, {0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 0, 0}};
-            H.adj = {{0, 1, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0, 0, 0, 0, 0}, 
-                     {0, 0, 0, 1, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 1, 0, 0, 0, 0, 0}, 
-                     {0, 0, 0, 0, 0, 1, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 1, 0, 0, 0}, 
-                     {0, 0, 0, 0, 0, 0, 0, 1, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 0}, 
-                     {0, 0, 0, 0, 0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 1, 0, 1, 0, 0, 0}};
+            G = Graph(vector<vector<int>>{{0, 1, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 1, 0, 0},
+                     {0, 0, 0, 0, 1, 0}, {0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 0, 0}});
+            H = Graph(vector<vector<int>>{{0, 1, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+                     {0, 0, 0, 1, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 1, 0, 0, 0, 0, 0},
+                     {0, 0, 0, 0, 0, 1, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 1, 0, 0, 0},
+                     {0, 0, 0, 0, 0, 0, 0, 1, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 0},
+                     {0, 0, 0, 0, 0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 1, 0, 1, 0, 0, 0}});
         } else if (gSize == 6 && hSize == 12) {
-            G.adj = {{0, 1, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 1, 1, 0}, 
-                     {0, 0, 0, 0, 1, 0}, {0, 0, 0, 0, 0, 1}, {1, 0, 0, 1, 0, 0}};
-            H.adj = {{0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 
-                     {0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0}, 
-                     {0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0}, 
-                     {0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0}, 
-                     {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0}, 
-                     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0}};
+            G = Graph(vector<vector<int>>{{0, 1, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0}, {0, 0, 0, 1, 1, 0},
+                     {0, 0, 0, 0, 1, 0}, {0, 0, 0, 0, 0, 1}, {1, 0, 0, 1, 0, 0}});
+            H = Graph(vector<vector<int>>{{0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+                     {0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+                     {0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0},
+                     {0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0},
+                     {0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0},
+                     {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}, {1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, 0}});
         } else if (gSize == 4 && hSize == 10) {
-            G.adj = {{0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}, {1, 0, 0, 0}};
-            H.adj = {{0, 1, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0, 0, 0, 0, 0}, 
-                     {0, 0, 0, 1, 0, 0, 0, 0, 0, 0}, {1, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 
-                     {0, 0, 0, 0, 0, 1, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 1, 0, 0, 0}, 
-                     {0, 0, 0, 0, 0, 0, 0, 1, 0, 0}, {0, 0, 0, 0, 1, 0, 0, 0, 0, 0}, 
-                     {0, 0, 0, 0, 0, 0, 0, 0, 0, 1}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 0}};
+            G = Graph(vector<vector<int>>{{0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}, {1, 0, 0, 0}});
+            H = Graph(vector<vector<int>>{{0, 1, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+                     {0, 0, 0, 1, 0, 0, 0, 0, 0, 0}, {1, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+                     {0, 0, 0, 0, 0, 1, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 1, 0, 0, 0},
+                     {0, 0, 0, 0, 0, 0, 0, 1, 0, 0}, {0, 0, 0, 0, 1, 0, 0, 0, 0, 0},
+                     {0, 0, 0, 0, 0, 0, 0, 0, 0, 1}, {0, 0, 0, 0, 0, 0, 0, 0, 1, 0}});
         } else {
             for (int i = 0; i < gSize - 1; ++i) {
-                G.adj[i][i+1] = 1;
+                G.addEdge(i, i + 1);
             }
-            G.adj[gSize-1][0] = 1;
-            
+            G.addEdge(gSize - 1, 0);
+
             for (int i = 0; i < hSize - 1; ++i) {
-                H.adj[i][i+1] = 1;
+                H.addEdge(i, i + 1);
             }
-            H.adj[hSize-1][0] = 1;
+            H.addEdge(hSize - 1, 0);
         }
-        
+
         return {G, H};
     }
 
-public:
-    void runBasicPerformanceTests() {
-        cout << "1. Basic Performance Comparison (Directed Graphs):" << endl;
-        cout << "===================================================" << endl;
-
-        vector<pair<int, int>> testCases = {{3, 5}, {4, 6}, {5, 8}, {6, 10}};
-
-        for (auto& testCase : testCases) {
-            int gSize = testCase.first;
-            int hSize = testCase.second;
+    BenchResult runCase(const BenchCase& c) {
+        BenchResult r;
+        r.id = c.id;
+        r.algorithm = c.algorithm;
+        r.n = c.G.size;
+        r.m = c.H.size;
+        r.density = c.density;
+        r.copies = c.copies;
+        r.trials = settings.trials;
+
+        for (int w = 0; w < settings.warmup; ++w) {
+            solve(c.algorithm, c.G, c.H, c.copies, c.options);
+        }
 
-            cout << "G(" << gSize << ") vs H(" << hSize << "):" << endl;
+        vector<double> times;
+        for (int t = 0; t < settings.trials; ++t) {
+            auto start = chrono::steady_clock::now();
+            SolveResult res = solve(c.algorithm, c.G, c.H, c.copies, c.options);
+            times.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
 
-            auto [G, H] = createFixedGraphs(gSize, hSize);
+            const int added = res.edgesHext - res.edgesH;
+            if (t > 0 && (res.copiesFound != r.copiesFound || added != r.edgesAdded)) {
+                cerr << "Warning: " << c.id << " gave different results between trials" << endl;
+            }
+            r.copiesFound = res.copiesFound;
+            r.edgesAdded = added;
+        }
 
-            TestResult exactResult = runExactTest(G, H, 1, 5000);
-            cout << "  Exact: " << fixed << setprecision(0) << exactResult.timeMs
-                 << "ms (cost " << exactResult.edgesAdded << ")" << endl;
+        sort(times.begin(), times.end());
+        r.medianMs = percentile(times, 50);
+        r.p10Ms = percentile(times, 10);
+        r.p90Ms = percentile(times, 90);
+        r.minMs = times.front();
+        r.maxMs = times.back();
+        return r;
+    }
 
-            auto approxResult = runApproximationTest(G, H, -1);
-            cout << "  Hungarian: " << fixed << setprecision(3) << approxResult.timeMs
-                 << "ms (" << approxResult.edgesAdded << " edges)" << endl;
-            cout << endl;
+public:
+    explicit TestRunner(const BenchSettings& settings) : settings(settings) {}
+
+    // The fixed exact-vs-hungarian instances, then the scaling sweeps over the
+    // sizes of G and H and the edge density of both.
+    void buildCases() {
+        const vector<pair<int, int>> fixedSizes = {{3, 5}, {4, 6}, {5, 8}, {6, 10}, {6, 12}};
+        for (const auto& size : fixedSizes) {
+            auto [G, H] = createFixedGraphs(size.first, size.second);
+            addCase("exact", "fixed", G, H, 0.0, 1);
+            addCase("hungarian", "fixed", G, H, 0.0, 1);
+            addCase("hungarian", "fixed", G, H, 0.0, -1);
+        }
+        auto [G4, H10] = createFixedGraphs(4, 10);
+        for (int copies : {2, 3}) {
+            addCase("exact", "fixed", G4, H10, 0.0, copies);
+            addCase("hungarian", "fixed", G4, H10, 0.0, copies);
         }
-    }
 
-    void runCopyTargetingTests() {
-        cout << "2. Exact vs Hungarian Approximation Analysis:" << endl;
-        cout << "=============================================" << endl;
-
-        GraphGenerator generator;
-
-        vector<pair<int, int>> comparableTests = {{3, 6}, {4, 8}, {5, 10}};
-
-        for (auto& testCase : comparableTests) {
-            int gSize = testCase.first;
-            int hSize = testCase.second;
-
-            cout << "Direct comparison G(" << gSize << ") vs H(" << hSize << "):" << endl;
-
-            auto [G, H] = createFixedGraphs(gSize, hSize);
-
-            TestResult exactResult = runExactTest(G, H, 1, 3000);
-            TestResult hungarianResult = runApproximationTest(G, H, 1);
-
-            if (exactResult.timeout) {
-                cout << "  Exact: TIMEOUT (>" << exactResult.timeMs << "ms)" << endl;
-                cout << "  Hungarian: " << fixed << setprecision(3) << hungarianResult.timeMs
-                     << "ms (" << hungarianResult.edgesAdded << " edges)" << endl;
-                cout << "  Approximation error: Cannot measure (exact timeout)" << endl;
-            } else {
-                cout << "  Exact: " << fixed << setprecision(0) << exactResult.timeMs
-                     << "ms (optimal: " << exactResult.edgesAdded << " edges)" << endl;
-                cout << "  Hungarian: " << fixed << setprecision(3) << hungarianResult.timeMs
-                     << "ms (approx: " << hungarianResult.edgesAdded << " edges)" << endl;
-
-                if (exactResult.edgesAdded == 0) {
-                    if (hungarianResult.edgesAdded == 0) {
-                        cout << "  Approximation error: 0% (both optimal)" << endl;
-                    } else {
-                        cout << "  Approximation error: INFINITE% (exact found subgraph, Hungarian didn't)" << endl;
-                    }
-                } else {
-                    double errorPercent = ((double)(hungarianResult.edgesAdded - exactResult.edgesAdded) / exactResult.edgesAdded) * 100.0;
-                    cout << "  Approximation error: " << fixed << setprecision(1) << errorPercent << "%" << endl;
+        const vector<int> exactN = settings.quick ? vector<int>{5, 6} : vector<int>{5, 6, 7, 8};
+        const vector<int> exactM = settings.quick ? vector<int>{10} : vector<int>{10, 14};
+        const vector<int> approxN = settings.quick ? vector<int>{10, 25} : vector<int>{10, 25, 50, 100};
+        const vector<int> approxM = settings.quick ? vector<int>{100, 300} : vector<int>{100, 300, 1000};
+        const vector<double> densities = settings.quick ? vector<double>{0.2} : vector<double>{0.1, 0.3, 0.6};
+
+        SolverOptions refine;
+        refine.refine = true;
+        SolverOptions portfolio;
+        portfolio.portfolio = 8;
+
+        uint32_t seed = 1;
+        for (double d : densities) {
+            for (int n : exactN) {
+                for (int m : exactM) {
+                    Graph G = randomGraph(n, d, seed++);
+                    Graph H = randomGraph(m, d, seed++);
+                    addCase("exact", "sweep", G, H, d, 1);
+                }
+            }
+            for (int n : approxN) {
+                for (int m : approxM) {
+                    Graph G = randomGraph(n, d, seed++);
+                    Graph H = randomGraph(m, d, seed++);
+                    // A fixed number of copies: "as many as possible" takes
+                    // thousands of copies at m = 1000 and would swamp the sweep.
+                    addCase("hungarian", "sweep", G, H, d, 1);
+                    addCase("hungarian", "sweep", G, H, d, 10);
+                    addCase("hungarian", "sweep", G, H, d, 1, refine, "+refine");
+                    addCase("hungarian", "sweep", G, H, d, 1, portfolio, "+portfolio8");
+                    addCase("auction", "sweep", G, H, d, 1);
+                    addCase("anneal", "sweep", G, H, d, 1);
                 }
-
-                double speedup = exactResult.timeMs / hungarianResult.timeMs;
-                cout << "  Hungarian speedup: " << fixed << setprecision(1) << speedup << "x faster" << endl;
             }
-            cout << endl;
         }
+    }
 
-        cout << "Exponential behavior demonstration G(6) vs H(12):" << endl;
-        auto [G6, H12] = createFixedGraphs(6, 12);
-
-        TestResult exactHardResult = runExactTest(G6, H12, 1, 5000);
-        TestResult hardApproxResult = runApproximationTest(G6, H12, 1);
-
-        if (exactHardResult.timeout) {
-            cout << "  Exact: TIMEOUT (>5s) - exponential complexity!" << endl;
-        } else {
-            cout << "  Exact: " << fixed << setprecision(0) << exactHardResult.timeMs
-                 << "ms (optimal: " << exactHardResult.edgesAdded << " edges)" << endl;
+    void runAll() {
+        cout << "Graph Algorithms Benchmark (" << cases.size() << " cases, " << settings.warmup << " warm-up + "
+             << settings.trials << " timed runs each, " << ThreadPool::shared().size() << " threads)" << endl;
+        cout << "========================================================================================" << endl;
+        cout << left << setw(44) << "case" << right << setw(11) << "median ms" << setw(11) << "p10 ms"
+             << setw(11) << "p90 ms" << setw(8) << "copies" << setw(8) << "edges" << endl;
+        for (const BenchCase& c : cases) {
+            BenchResult r = runCase(c);
+            cout << left << setw(44) << r.id << right << fixed << setprecision(3) << setw(11) << r.medianMs
+                 << setw(11) << r.p10Ms << setw(11) << r.p90Ms << setw(8) << r.copiesFound << setw(8) << r.edgesAdded << endl;
+            results.push_back(r);
         }
-        cout << "  Hungarian: " << fixed << setprecision(3) << hardApproxResult.timeMs
-             << "ms (approx: " << hardApproxResult.edgesAdded << " edges)" << endl;
-        cout << "  Demonstrates: Exact becomes impractical, Hungarian stays fast" << endl;
-        cout << endl;
+    }
 
-        cout << "Testing multiple copies G(4) vs H(10):" << endl;
-        auto [G4, H10] = createFixedGraphs(4, 10);
+    static const char* csvHeader() {
+        return "case,algorithm,n,m,density,copies,trials,median_ms,p10_ms,p90_ms,min_ms,max_ms,copies_found,edges_added";
+    }
 
-        for (int copies : {1, 2, 3}) {
-            cout << "Target: " << copies << " copy/copies" << endl;
+    bool writeCsv(const string& path) const {
+        ofstream out(path, ios::trunc);
+        if (!out.is_open()) {
+            cerr << "Error: Could not create file " << path << endl;
+            return false;
+        }
+        out << csvHeader() << "\n" << setprecision(6);
+        for (const BenchResult& r : results) {
+            out << r.id << "," << r.algorithm << "," << r.n << "," << r.m << "," << r.density << "," << r.copies << ","
+                << r.trials << "," << r.medianMs << "," << r.p10Ms << "," << r.p90Ms << "," << r.minMs << ","
+                << r.maxMs << "," << r.copiesFound << "," << r.edgesAdded << "\n";
+        }
+        return static_cast<bool>(out);
+    }
 
-            TestResult multiExactResult = runExactTest(G4, H10, copies, 1000);
-            if (multiExactResult.timeout) {
-                cout << "  Exact: TIMEOUT" << endl;
-            } else {
-                cout << "  Exact: " << multiExactResult.copiesFound << " copies, "
-                     << multiExactResult.edgesAdded << " edges, "
-                     << fixed << setprecision(0) << multiExactResult.timeMs << "ms" << endl;
+    // Baseline rows by case id; columns are found by header name.
+    static bool readCsv(const string& path, map<string, BenchResult>& out) {
+        ifstream in(path);
+        if (!in.is_open()) {
+            cerr << "Error: Could not open baseline " << path << endl;
+            return false;
+        }
+        auto split = [](const string& line) {
+            vector<string> fields;
+            stringstream ss(line);
+            string field;
+            while (getline(ss, field, ',')) fields.push_back(field);
+            return fields;
+        };
+
+        string line;
+        if (!getline(in, line)) return true;
+        map<string, size_t> column;
+        const vector<string> header = split(line);
+        for (size_t k = 0; k < header.size(); ++k) column[header[k]] = k;
+        for (const char* name : { "case", "median_ms", "copies_found", "edges_added" }) {
+            if (!column.count(name)) {
+                cerr << "Error: " << path << " has no '" << name << "' column" << endl;
+                return false;
             }
+        }
 
-            auto multiApproxResult = runApproximationTest(G4, H10, copies);
-            cout << "  Hungarian: " << multiApproxResult.copiesFound << " copies, "
-                 << multiApproxResult.edgesAdded << " edges, "
-                 << fixed << setprecision(3) << multiApproxResult.timeMs << "ms, Target: "
-                 << multiApproxResult.status << endl;
-            cout << endl;
+        for (int lineNo = 2; getline(in, line); ++lineNo) {
+            const vector<string> f = split(line);
+            if (f.size() < header.size()) continue;
+            try {
+                BenchResult r;
+                r.id = f[column["case"]];
+                r.medianMs = stod(f[column["median_ms"]]);
+                r.copiesFound = stoi(f[column["copies_found"]]);
+                r.edgesAdded = stoi(f[column["edges_added"]]);
+                out[r.id] = r;
+            }
+            catch (...) {
+                cerr << "Error: " << path << ":" << lineNo << ": invalid number" << endl;
+                return false;
+            }
         }
+        return true;
     }
 
-
+    // Prints the cases that got slower or worse than the baseline; returns how many.
+    int compareWithBaseline(const map<string, BenchResult>& baseline) const {
+        cout << "\nComparison with baseline (tolerance " << fixed << setprecision(1) << settings.tolerancePct << "%):" << endl;
+        int regressions = 0;
+        int compared = 0;
+        double logRatioSum = 0.0;
+        for (const BenchResult& r : results) {
+            auto it = baseline.find(r.id);
+            if (it == baseline.end()) continue;
+            const BenchResult& b = it->second;
+            compared++;
+            if (b.medianMs > 0 && r.medianMs > 0) logRatioSum += log(r.medianMs / b.medianMs);
+
+            const bool slower = r.medianMs > b.medianMs * (1.0 + settings.tolerancePct / 100.0) &&
+                                r.medianMs - b.medianMs > settings.noiseFloorMs;
+            const bool worse = r.copiesFound < b.copiesFound ||
+                               (r.copiesFound == b.copiesFound && r.edgesAdded > b.edgesAdded);
+            if (slower) {
+                cout << "  SLOWER  " << r.id << ": " << setprecision(3) << b.medianMs << " -> " << r.medianMs << " ms" << endl;
+            }
+            if (worse) {
+                cout << "  WORSE   " << r.id << ": " << b.copiesFound << " copies / " << b.edgesAdded << " edges -> "
+                     << r.copiesFound << " copies / " << r.edgesAdded << " edges" << endl;
+            }
+            if (slower || worse) regressions++;
+        }
+        cout << "  " << compared << " cases compared, " << regressions << " regressions";
+        if (compared > 0) {
+            cout << ", geometric mean time ratio " << setprecision(3) << exp(logRatioSum / compared);
+        }
+        cout << endl;
+        return regressions;
+    }
 };
 
-int main() {
-    cout << "Graph Algorithms Test Suite" << endl;
-    cout << "============================" << endl;
-    cout << endl;
+int main(int argc, char* argv[]) {
+    BenchSettings settings;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        try {
+            if (arg == "--quick") {
+                settings.quick = true;
+            }
+            else if (arg == "--warmup" && i + 1 < argc) {
+                settings.warmup = max(0, stoi(argv[++i]));
+            }
+            else if (arg == "--trials" && i + 1 < argc) {
+                settings.trials = max(1, stoi(argv[++i]));
+            }
+            else if (arg == "--filter" && i + 1 < argc) {
+                settings.filter = argv[++i];
+            }
+            else if (arg == "--output" && i + 1 < argc) {
+                settings.outputFile = argv[++i];
+            }
+            else if (arg == "--baseline" && i + 1 < argc) {
+                settings.baselineFile = argv[++i];
+            }
+            else if (arg == "--tolerance" && i + 1 < argc) {
+                settings.tolerancePct = stod(argv[++i]);
+            }
+            else if (arg == "--threads" && i + 1 < argc) {
+                ThreadPool::setDefaultThreads(stoi(argv[++i]));
+            }
+            else {
+                cerr << "Usage: " << argv[0] << " [--quick] [--warmup N] [--trials N] [--filter TEXT] [--threads N]"
+                     << " [--output results.csv] [--baseline baseline.csv] [--tolerance PERCENT]" << endl;
+                return 1;
+            }
+        }
+        catch (...) {
+            cerr << "Error: invalid value for " << arg << endl;
+            return 1;
+        }
+    }
+
+    // Read the baseline first so a bad path fails before the long run.
+    map<string, BenchResult> baseline;
+    if (!settings.baselineFile.empty() && !TestRunner::readCsv(settings.baselineFile, baseline)) {
+        return 1;
+    }
 
-    TestRunner runner;
+    TestRunner runner(settings);
+    runner.buildCases();
+    runner.runAll();
 
-    runner.runBasicPerformanceTests();
-    runner.runCopyTargetingTests();
+    if (!settings.outputFile.empty() && !runner.writeCsv(settings.outputFile)) {
+        return 1;
+    }
+    if (!settings.baselineFile.empty() && runner.compareWithBaseline(baseline) > 0) {
+        return 2;
+    }
 
     cout << "Done." << endl;
     return 0;